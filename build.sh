@@ -2,6 +2,7 @@
 
 echo "Cleaning.."
 rm -f ./bin/uxnasm
+rm -f ./bin/uxn2c
 rm -f ./bin/uxnemu
 rm -f ./bin/uxncli
 rm -f ./bin/boot.rom
@@ -42,6 +43,12 @@ then
 	echo "[debug]"
 	CFLAGS="${CFLAGS} -DDEBUG -Wpedantic -Wshadow -Wextra -Werror=implicit-int -Werror=incompatible-pointer-types -Werror=int-conversion -Wvla -g -Og -fsanitize=address -fsanitize=undefined"
 	CORE='src/uxn.c'
+elif [ "${1}" = '--jit' ];
+then
+	echo "[jit]"
+	CFLAGS="${CFLAGS} -DNDEBUG -DUXN_JIT -Os -g0 -s"
+	CORE='src/uxn.c src/uxn-jit.c'
+	UXNEMU_LDFLAGS="${UXNEMU_LDFLAGS} -lpthread"
 else
 	CFLAGS="${CFLAGS} -DNDEBUG -Os -g0 -s"
 	CORE='src/uxn-fast.c'
@@ -49,13 +56,14 @@ fi
 
 echo "Building.."
 cc ${CFLAGS} src/uxnasm.c -o bin/uxnasm
-cc ${CFLAGS} ${CORE} src/devices/ppu.c src/devices/apu.c src/uxnemu.c ${UXNEMU_LDFLAGS} -o bin/uxnemu
-cc ${CFLAGS} ${CORE} src/uxncli.c -o bin/uxncli
+cc ${CFLAGS} src/uxn2c.c -o bin/uxn2c
+cc ${CFLAGS} ${CORE} -DUXNASM_LIB src/uxnasm.c src/devices/ppu.c src/devices/apu.c src/devices/file.c src/uxnemu.c ${UXNEMU_LDFLAGS} -o bin/uxnemu
+cc ${CFLAGS} ${CORE} -DUXNASM_LIB src/uxnasm.c src/devices/file.c src/uxncli.c -lpthread -o bin/uxncli
 
 if [ -d "$HOME/bin" ]
 then
 	echo "Installing in $HOME/bin"
-	cp bin/uxnemu bin/uxnasm bin/uxncli $HOME/bin/
+	cp bin/uxnemu bin/uxnasm bin/uxncli bin/uxn2c $HOME/bin/
 fi
 
 # echo "Assembling(uxnasm).."
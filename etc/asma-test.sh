@@ -15,27 +15,39 @@ expect_failure() {
 
 echo 'Assembling asma with uxnasm'
 bin/uxnasm projects/software/asma.tal asma-test/asma.rom > asma-test/uxnasm.log
+mkdir asma-test/in asma-test/uxnasm asma-test/uxnasm-1 asma-test/asma
+PAIRS=
+PAIRS1=
 for F in $(find projects -path projects/library -prune -false -or -type f -name '*.tal' | sort); do
-	echo "Comparing assembly of ${F}"
-
-	UASM_BASE="asma-test/uxnasm-$(basename "${F%.tal}")"
-	if ! bin/uxnasm "${F}" "${UASM_BASE}.rom" 2> "${UASM_BASE}.log"; then
-		echo "error: uxnasm failed to assemble ${F}"
-		cat "${UASM_BASE}.log"
-		exit 1
-	fi
-	xxd "${UASM_BASE}.rom" > "${UASM_BASE}.hex"
-
-	ASMA_BASE="asma-test/asma-$(basename "${F%.tal}")"
-	echo "${F}" | bin/uxncli asma-test/asma.rom > "${ASMA_BASE}.rom" 2> "${ASMA_BASE}.log"
-	if ! grep -qF 'bytes of heap used' "${ASMA_BASE}.log"; then
-		echo "error: asma failed to assemble ${F}, while uxnasm succeeded"
-		cat "${ASMA_BASE}.log"
-		exit 1
-	fi
-	xxd "${ASMA_BASE}.rom" > "${ASMA_BASE}.hex"
+	B="$(basename "${F%.tal}")"
+	PAIRS="${PAIRS} ${F} asma-test/uxnasm/${B}.rom"
+	PAIRS1="${PAIRS1} ${F} asma-test/uxnasm-1/${B}.rom"
+	echo "${F}" > "asma-test/in/${B}"
+	echo "asma-test/asma.rom asma-test/in/${B} asma-test/asma/${B}.rom" >> asma-test/asma.jobs
+done
 
-	diff -u "${UASM_BASE}.hex" "${ASMA_BASE}.hex"
+echo "Comparing assembly of $(ls asma-test/in | wc -l) files"
+if ! bin/uxnasm ${PAIRS} 2> asma-test/uxnasm.log; then
+	echo "error: uxnasm failed to assemble"
+	grep -v '^--- ' asma-test/uxnasm.log
+	exit 1
+fi
+rm -f asma-test/uxnasm/*.sym
+if ! bin/uxnasm -1 ${PAIRS1} 2> asma-test/uxnasm-1.log || ! diff -r -x '*.sym' asma-test/uxnasm asma-test/uxnasm-1 > /dev/null; then
+	echo "error: uxnasm -1 and uxnasm disagree"
+	grep -v '^--- ' asma-test/uxnasm-1.log
+	diff -rq -x '*.sym' asma-test/uxnasm asma-test/uxnasm-1
+	exit 1
+fi
+bin/uxncli -b asma-test/asma.jobs > asma-test/batch.log 2> asma-test/asma.log || true
+for R in $(diff -rq asma-test/uxnasm asma-test/asma 2>&1 | sed -n 's/^Files asma-test\/uxnasm\/\([^ ]*\) and .*/\1/p; s/^Only in asma-test\/uxnasm: //p'); do
+	F="$(cat "asma-test/in/${R%.rom}")"
+	echo "error: asma and uxnasm disagree on ${F}"
+	bin/uxncli asma-test/asma.rom < "asma-test/in/${R%.rom}" > /dev/null
+	xxd "asma-test/uxnasm/${R}" > asma-test/uxnasm.hex
+	xxd "asma-test/asma/${R}" > asma-test/asma.hex 2> /dev/null || true
+	diff -u asma-test/uxnasm.hex asma-test/asma.hex
+	exit 1
 done
 expect_failure 'Invalid hexadecimal: $defg' <<'EOD'
 |1000 $defg
@@ -0,0 +1,65 @@
+#!/bin/sh
+set -e
+cd "$(dirname "${0}")/.."
+rm -rf jit-test
+mkdir jit-test
+
+# every rom in projects/, and a few that poke at the edges of translation,
+# must end with the same memory, stacks and device writes under src/uxn.c
+# with and without src/uxn-jit.c
+
+tal() {
+	cat > "jit-test/${1}.tal"
+}
+
+tal smc <<'TAL'
+|0100
+	#00
+	&loop
+		DUP ,&patch STR
+		LIT &patch 00
+		;sum LDA ADD ;sum STA
+		INC DUP #20 NEQ ,&loop JCN
+	POP
+	BRK
+@sum $1
+TAL
+
+tal wrap <<'TAL'
+|0100
+	#4142 #ffff STA2
+	#0000 LDA #ffff LDA2
+	#1234 ;here #00fe SUB2 STA2
+	#fe LDZ2 #ff LDR2
+	BRK
+@here
+TAL
+
+tal div <<'TAL'
+|0100
+	#01 #00 ;at JMP2 @at DIV
+	BRK
+TAL
+
+CF='-std=c89 -Wall -Wno-unknown-pragmas -DNDEBUG -O2 -Isrc'
+echo 'Building src/uxn.c with and without src/uxn-jit.c'
+cc ${CF} etc/uxn-state.c src/uxn.c -lpthread -o jit-test/uxn-state
+cc ${CF} -DUXN_JIT etc/uxn-state.c src/uxn.c src/uxn-jit.c -lpthread -o jit-test/uxn-state-jit
+FILES="$(find projects -path projects/library -prune -false -or -type f -name '*.tal' | sort) $(ls jit-test/*.tal)"
+N=0
+FAILED=0
+for F in ${FILES}; do
+	R="jit-test/$(basename "${F%.tal}").rom"
+	bin/uxnasm "${F}" "${R}" > /dev/null 2>&1 || { echo "error: uxnasm failed on ${F}"; exit 1; }
+	N=$((N + 1))
+	A="$(timeout 20 jit-test/uxn-state "${R}")" || true
+	B="$(timeout 20 jit-test/uxn-state-jit "${R}")" || true
+	if [ -z "${A}" ] || [ "${A}" != "${B}" ]; then
+		echo "error: the JIT and the interpreter disagree on ${F}"
+		FAILED=1
+	fi
+done
+echo "Compared ${N} roms"
+[ "${FAILED}" = 0 ]
+rm -rf jit-test
+echo 'All OK'
@@ -1,15 +1,80 @@
 local generate_labels = false
 local replacements = {
-  op_and16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d & b); push8(u->src, c & a); }',
-  op_ora16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d | b); push8(u->src, c | a); }',
-  op_eor16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d ^ b); push8(u->src, c ^ a); }',
-  op_lit16 = '{ push8(u->src, peek8(u->ram.dat, u->ram.ptr++)); push8(u->src, peek8(u->ram.dat, u->ram.ptr++)); }',
-  op_swp16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, b); push8(u->src, a); push8(u->src, d); push8(u->src, c); }',
-  op_ovr16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d); push8(u->src, c); push8(u->src, b); push8(u->src, a); push8(u->src, d); push8(u->src, c); }',
-  op_dup16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src); push8(u->src, b); push8(u->src, a); push8(u->src, b); push8(u->src, a); }',
-  op_rot16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src), e = pop8(u->src), f = pop8(u->src); push8(u->src, d); push8(u->src, c); push8(u->src, b); push8(u->src, a); push8(u->src, f); push8(u->src, e); }',
-  op_sth16 = '{ Uint8 a = pop8(u->src), b = pop8(u->src); push8(u->dst, b); push8(u->dst, a); }'
+  AND2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d & b); push8(u->src, c & a); }',
+  ORA2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d | b); push8(u->src, c | a); }',
+  EOR2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d ^ b); push8(u->src, c ^ a); }',
+  SWP2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, b); push8(u->src, a); push8(u->src, d); push8(u->src, c); }',
+  OVR2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src); push8(u->src, d); push8(u->src, c); push8(u->src, b); push8(u->src, a); push8(u->src, d); push8(u->src, c); }',
+  DUP2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src); push8(u->src, b); push8(u->src, a); push8(u->src, b); push8(u->src, a); }',
+  ROT2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src), c = pop8(u->src), d = pop8(u->src), e = pop8(u->src), f = pop8(u->src); push8(u->src, d); push8(u->src, c); push8(u->src, b); push8(u->src, a); push8(u->src, f); push8(u->src, e); }',
+  STH2 = '{ Uint8 a = pop8(u->src), b = pop8(u->src); push8(u->dst, b); push8(u->dst, a); }'
 }
+local modes = {
+  ['8'] = {
+    warp = 'u->ram.ptr += (Sint8)%s',
+    pull = 'push8(u->src, peek8(u->ram.dat, u->ram.ptr++))'
+  },
+  ['16'] = {
+    warp = 'u->ram.ptr = %s',
+    pull = 'push8(u->src, peek8(u->ram.dat, u->ram.ptr++)); push8(u->src, peek8(u->ram.dat, u->ram.ptr++))'
+  }
+}
+local fused = {
+  ['8'] = {
+    0x0d,
+    0x1c,
+    0x0c,
+    0x0e,
+    0x17,
+    0x05,
+    0x3f,
+    0x1f,
+    0x0b,
+    0x19,
+    0x18
+  },
+  ['16'] = {
+    0x38,
+    0x35,
+    0x34,
+    0x2e,
+    0x2c
+  }
+}
+local literal = {
+  ['8'] = 'peek8(u->ram.dat, (u->ram.ptr += 2) - 2)',
+  ['16'] = 'peek16(u->ram.dat, (u->ram.ptr += 3) - 3)'
+}
+local moded = {
+  push = true,
+  pop = true,
+  poke = true,
+  peek = true,
+  devw = true,
+  devr = true
+}
+local specialise
+specialise = function(body, n)
+  body = body:gsub('%f[%w](%l+)%(', function(fn)
+    if moded[fn] then
+      return ('%s%s('):format(fn, n)
+    end
+  end)
+  body = body:gsub('%f[%w]warp%(u, (.-)%)', function(a)
+    return modes[n].warp:format(a)
+  end)
+  body = body:gsub('%f[%w]pull%(u%)', modes[n].pull)
+  body = body:gsub('([a-c]) = pop(%d+)(%b())[,;] *', function(v, m, args)
+    return ('Uint%s %s = pop%s%s; '):format(m, v, m, args)
+  end)
+  while true do
+    local merged
+    body, merged = body:gsub('(Uint(%d+) [^;]+); Uint%2 ', '%1, ')
+    if merged == 0 then
+      return body
+    end
+  end
+end
 local top, bottom, pushtop
 local offset
 offset = function(n, s)
@@ -58,7 +123,10 @@ pop_push = function(k, n, s)
       if v:match('%+%+') or v:match('%-%-') then
         error('push16 has side effects: ' .. v)
       end
-      local peek, args = v:match('^([md]e[mv]peek)16(%b())$')
+      local peek, args = v:match('^(peek)16(%b())$')
+      if not peek then
+        peek, args = v:match('^(devr)16(%b())$')
+      end
       if peek then
         args = args:sub(2, -2)
         return pop_push('push', '8', ('(%s, %s8(%s))'):format(s, peek, args)) .. ';\n' .. pop_push('push', '8', ('(%s, %s8(%s + 1))'):format(s, peek, args))
@@ -83,6 +151,7 @@ local process
 process = function(body)
   local out_body = body:gsub('^%{ *', ''):gsub(' *%}$', ''):gsub('; ', ';\n'):gsub('%b{} *', indented_block):gsub('(%a+)(%d+)(%b())', pop_push)
   local in_ifdef = false
+  local tail = ''
   local _list_0 = {
     'src',
     'dst'
@@ -91,30 +160,39 @@ process = function(body)
     local k = _list_0[_index_0]
     if bottom[k] ~= 0 then
       if not in_ifdef then
-        out_body = out_body .. '\n#ifndef NO_STACK_CHECKS'
+        tail = tail .. '\n#ifndef NO_STACK_CHECKS'
         in_ifdef = true
       end
-      out_body = out_body .. ('\nif(__builtin_expect(%s.ptr < %d, 0)) {\n\t%s.error = 1;\n\tgoto error;\n}'):format(k, -bottom[k], k)
+      tail = tail .. ('\nif(__builtin_expect(%s.ptr < %d, 0)) {\n\t%s.error = 1;\n\tgoto error;\n}'):format(k, -bottom[k], k)
     end
     if pushtop[k] ~= 0 then
       if pushtop[k] > 0 then
         if not in_ifdef then
-          out_body = out_body .. '\n#ifndef NO_STACK_CHECKS'
+          tail = tail .. '\n#ifndef NO_STACK_CHECKS'
           in_ifdef = true
         end
-        out_body = out_body .. ('\nif(__builtin_expect(%s.ptr > %d, 0)) {\n\t%s.error = 2;\n\tgoto error;\n}'):format(k, 255 - pushtop[k], k)
+        tail = tail .. ('\nif(__builtin_expect(%s.ptr > %d, 0)) {\n\t%s.error = 2;\n\tgoto error;\n}'):format(k, 255 - pushtop[k], k)
       end
       if in_ifdef then
-        out_body = out_body .. '\n#endif'
+        tail = tail .. '\n#endif'
         in_ifdef = false
       end
-      out_body = out_body .. ('\n%s.ptr %s= %d;'):format(k, pushtop[k] < 0 and '-' or '+', math.abs(pushtop[k]))
+      tail = tail .. ('\n%s.ptr %s= %d;'):format(k, pushtop[k] < 0 and '-' or '+', math.abs(pushtop[k]))
     end
   end
   if in_ifdef then
-    out_body = out_body .. '\n#endif'
+    tail = tail .. '\n#endif'
     in_ifdef = false
   end
+  local device = out_body:find('\nif %(!devw')
+  if device then
+    out_body = out_body:sub(1, device - 1) .. tail .. out_body:sub(device)
+  else
+    out_body = out_body .. tail
+  end
+  if out_body:find('steps%-%-') then
+    out_body = out_body .. '\nif(__builtin_expect(!steps, 0))\n\tgoto suspend;'
+  end
   local t = { }
   out_body:gsub('[^%w_]([a-f]) = (src%.dat%[[^]]+%])[,;]', function(v, k)
     t[k] = v
@@ -128,109 +206,132 @@ process = function(body)
   return out_body
 end
 local ops = { }
+local sources = { }
 for l in assert(io.lines('src/uxn.c')) do
   local _continue_0 = false
   repeat
-    local name, body = l:match('void (op_%S*)%(Uxn %*u%) (%b{})')
-    if not name then
+    local n, name, body = l:match('^%s*case 0x(%x%x): /%* (%u+) %*/ (.-) break;$')
+    if not n then
       _continue_0 = true
       break
     end
-    if replacements[name] then
-      body = replacements[name]
-    end
-    body = body:gsub('u%-%>src%-%>', 'src.')
-    body = body:gsub('u%-%>dst%-%>', 'dst.')
-    body = body:gsub('u%-%>src', 'src')
-    body = body:gsub('u%-%>dst', 'dst')
-    top = {
-      src = 0,
-      dst = 0
-    }
-    bottom = {
-      src = 0,
-      dst = 0
-    }
-    pushtop = top
-    ops[name] = process(body)
-    top = {
-      src = 0,
-      dst = 0
-    }
-    bottom = {
-      src = 0,
-      dst = 0
-    }
-    pushtop = {
-      src = 0,
-      dst = 0
+    n = tonumber(n, 16)
+    local _list_0 = {
+      '8',
+      '16'
     }
-    ops['keep_' .. name] = process(body)
+    for _index_0 = 1, #_list_0 do
+      local m = _list_0[_index_0]
+      local short = m == '16' and 0x20 or 0x00
+      local b = replacements[name .. (short ~= 0 and '2' or '')] or specialise(('{ %s }'):format(body), m)
+      b = b:gsub('u%-%>src%-%>', 'src.')
+      b = b:gsub('u%-%>dst%-%>', 'dst.')
+      b = b:gsub('u%-%>src', 'src')
+      b = b:gsub('u%-%>dst', 'dst')
+      top = {
+        src = 0,
+        dst = 0
+      }
+      bottom = {
+        src = 0,
+        dst = 0
+      }
+      pushtop = top
+      sources[n + short] = b
+      ops[n + short] = process(b)
+      top = {
+        src = 0,
+        dst = 0
+      }
+      bottom = {
+        src = 0,
+        dst = 0
+      }
+      pushtop = {
+        src = 0,
+        dst = 0
+      }
+      ops[n + short + 0x80] = process(b)
+    end
     _continue_0 = true
   until true
   if not _continue_0 then
     break
   end
 end
+local spill = {
+  'u->ram.ptr = pc;',
+  'u->wst.ptr = wptr;',
+  'u->rst.ptr = rptr;'
+}
+local reload = {
+  'pc = u->ram.ptr;',
+  'wptr = u->wst.ptr;',
+  'rptr = u->rst.ptr;'
+}
 local dump
 dump = function(s, src, dst)
+  s = s:gsub('u%->ram%.ptr', 'pc'):gsub('src%.ptr', src:sub(1, 1) .. 'ptr'):gsub('dst%.ptr', dst:sub(1, 1) .. 'ptr')
+  s = s:gsub('src', 'u->' .. src):gsub('dst', 'u->' .. dst)
+  local lines
+  do
+    local _accum_0 = { }
+    local _len_0 = 1
+    for l in s:gmatch('[^\n]+') do
+      _accum_0[_len_0] = l
+      _len_0 = _len_0 + 1
+    end
+    lines = _accum_0
+  end
+  local first, last
+  for i, l in ipairs(lines) do
+    if l:match('dev[rw]%d+%(') then
+      first = first or i
+      last = i
+    end
+  end
   local ret = '\t\t\t{\n'
-  for l in s:gmatch('[^\n]+') do
+  for i, l in ipairs(lines) do
+    if i == first then
+      for _index_0 = 1, #spill do
+        local c = spill[_index_0]
+        ret = ret .. ('\t\t\t\t%s\n'):format(c)
+      end
+    end
     if not l:match('^%#') then
       ret = ret .. '\t\t\t\t'
     end
     ret = ret .. ('%s\n'):format(l)
-  end
-  ret = ret .. '\t\t\t}\n\t\t\tbreak;\n'
-  return (ret:gsub('src', src):gsub('dst', dst))
-end
-local i = 0
-local allops = { }
-local wanted = false
-for l in assert(io.lines('src/uxn.c')) do
-  if l == 'static void (*ops[])(Uxn *u) = {' then
-    wanted = true
-  elseif l == '};' then
-    wanted = false
-  elseif wanted then
-    l = l:gsub('%/%b**%/', '')
-    for op in l:gmatch('[%w_]+') do
-      if not ops[op] then
-        error('missing ' .. op)
-      end
-      allops[i + 0x00 + 1] = {
-        n = {
-          i + 0x00
-        },
-        body = dump(ops[op], 'u->wst', 'u->rst')
-      }
-      allops[i + 0x20 + 1] = {
-        n = {
-          i + 0x20
-        },
-        body = dump(ops[op], 'u->rst', 'u->wst')
-      }
-      allops[i + 0x80 + 1] = {
-        n = {
-          i + 0x80
-        },
-        body = dump(ops['keep_' .. op], 'u->wst', 'u->rst')
-      }
-      allops[i + 0xa0 + 1] = {
-        n = {
-          i + 0xa0
-        },
-        body = dump(ops['keep_' .. op], 'u->rst', 'u->wst')
-      }
-      i = i + 1
-      if i == 0x20 then
-        i = i + 0x20
+    if i == last then
+      for _index_0 = 1, #reload do
+        local c = reload[_index_0]
+        ret = ret .. ('\t\t\t\t%s\n'):format(c)
       end
     end
   end
+  return ret .. '\t\t\t}\n\t\t\tNEXT;\n'
+end
+local unwrap
+unwrap = function(s)
+  return s:match('^\t\t\t{\n(.*)\t\t\t}\n\t\t\tNEXT;\n$')
+end
+local allops = { }
+for n, body in pairs(ops) do
+  allops[n + 0x00 + 1] = {
+    n = {
+      n + 0x00
+    },
+    body = dump(body, 'wst', 'rst')
+  }
+  allops[n + 0x40 + 1] = {
+    n = {
+      n + 0x40
+    },
+    body = dump(body, 'rst', 'wst')
+  }
 end
-i = 0
-wanted = false
+local i = 0
+local wanted = false
 for l in assert(io.lines('src/uxnasm.c')) do
   if l == 'static char ops[][4] = {' then
     wanted = true
@@ -240,33 +341,56 @@ for l in assert(io.lines('src/uxnasm.c')) do
     for op in l:gmatch('"(...)"') do
       i = i + 1
       allops[i + 0x00].name = op
-      allops[i + 0x20].name = op .. 'r'
-      allops[i + 0x40].name = op .. '2'
+      allops[i + 0x20].name = op .. '2'
+      allops[i + 0x40].name = op .. 'r'
       allops[i + 0x60].name = op .. '2r'
       allops[i + 0x80].name = op .. 'k'
-      allops[i + 0xa0].name = op .. 'kr'
-      allops[i + 0xc0].name = op .. '2k'
+      allops[i + 0xa0].name = op .. '2k'
+      allops[i + 0xc0].name = op .. 'kr'
       allops[i + 0xe0].name = op .. '2kr'
     end
   end
 end
-for i = 1, 256 do
-  local _continue_0 = false
-  repeat
-    if not allops[i] then
-      _continue_0 = true
-      break
+local _list_0 = {
+  '8',
+  '16'
+}
+for _index_0 = 1, #_list_0 do
+  local m = _list_0[_index_0]
+  local n = m == '16' and 0x20 or 0x00
+  local body = ''
+  local _list_1 = fused[m]
+  for _index_1 = 1, #_list_1 do
+    local x = _list_1[_index_1]
+    if sources[x]:match('pop(%d+)%(src%)') ~= m then
+      error(('cannot fuse %s with %s'):format(allops[n + 0x81].name, allops[x + 1].name))
     end
-    for j = i + 1, 256 do
-      if allops[i].body == allops[j].body then
-        table.insert(allops[i].n, (table.remove(allops[j].n)))
-        allops[j].body = nil
-      end
+    top = {
+      src = 0,
+      dst = 0
+    }
+    bottom = {
+      src = 0,
+      dst = 0
+    }
+    pushtop = top
+    local b = process((sources[x]:gsub('pop%d+%(src%)', literal[m], 1)))
+    b = b:gsub('goto error;', ('instr = 0x%02x;\n\tgoto error;'):format(x))
+    body = body .. ('%sif(u->ram.dat[(Uint16)(pc + %d)] == 0x%02x) { /* %s */\n%s\t\t\t}'):format(body == '' and '\t\t\t' or ' else ', m == '16' and 2 or 1, x, allops[x + 1].name, unwrap(dump(b, 'wst', 'rst')))
+  end
+  body = body .. (' else {\n%s\t\t\t}\n\t\t\tNEXT;\n'):format(unwrap(allops[n + 1].body))
+  allops[n + 1].body = body
+  allops[n + 0x81].body = body
+end
+for i = 1, 256 do
+  if not allops[i] then
+    error(('missing opcode 0x%02x'):format(i - 1))
+  end
+  for j = i + 1, 256 do
+    if allops[i].body == allops[j].body then
+      table.insert(allops[i].n, (table.remove(allops[j].n)))
+      allops[j].body = nil
     end
-    _continue_0 = true
-  until true
-  if not _continue_0 then
-    break
   end
 end
 do
@@ -289,46 +413,69 @@ Its contents can get overwritten with the processed contents of src/uxn.c.
 See etc/mkuxn-fast.moon for instructions.
 
 */
+
 ]])
-  wanted = true
+  local helpers = { }
   while true do
-    local _continue_0 = false
-    repeat
-      local l = f:read('*l')
-      if l:match(' push') or l:match('[ *]pop') or l:match('devr16') then
-        _continue_0 = true
-        break
-      end
-      if l == '/* Stack */' then
-        wanted = false
-      end
-      if wanted then
-        _with_0:write(('%s\n'):format(l))
-      end
-      if l == '}' then
-        _with_0:write('\n')
-        break
-      end
-      _continue_0 = true
-    until true
-    if not _continue_0 then
+    local l = f:read('*l')
+    if l == '#pragma mark - Core' then
       break
     end
+    if l:match('^#define') then
+      _with_0:write(('%s\n'):format(l))
+    end
+    local fn = l:match('^%s*%a*%s*%a+%d*%s+(%l+8)%(') or l:match('^%s*%a*%s*%a+%d*%s+(%l+16)%(')
+    if fn and not fn:match('^pu') and not fn:match('^pop') and fn ~= 'devr16' and fn ~= 'warp8' and fn ~= 'warp16' then
+      table.insert(helpers, (l:gsub('^%s+', '')))
+    end
   end
-  _with_0:write([[/* clang-format on */
+  _with_0:write('\n#pragma mark - Operations\n\n/* clang-format off */\n')
+  for _index_0 = 1, #helpers do
+    local l = helpers[_index_0]
+    _with_0:write(('%s\n'):format(l))
+  end
+  _with_0:write([[
+
+/* clang-format on */
+
+#ifdef THREADED_DISPATCH
+#define CASE(n) op_##n:
+#define NEXT goto *dispatch[(instr = u->ram.dat[pc++])]
+#else
+#define CASE(n) case n:
+#define NEXT break
+#endif
 
 #pragma mark - Core
 
 int
-uxn_eval(Uxn *u, Uint16 vec)
+uxn_resume(Uxn *u, unsigned int steps)
 {
-	Uint8 instr;
-	if(!vec || u->dev[0].dat[0xf]) 
-		return 0;
-	u->ram.ptr = vec;
-	if(u->wst.ptr > 0xf8) u->wst.ptr = 0xf8;
-	while((instr = u->ram.dat[u->ram.ptr++])) {
+	Uint8 instr, wptr, rptr;
+	Uint16 pc;
+#ifdef THREADED_DISPATCH
+	static void *dispatch[] = {
+]])
+  for i = 0, 255, 8 do
+    _with_0:write('\t\t')
+    for n = i, i + 7 do
+      _with_0:write(n == 0 and '&&brk' or ('&&op_0x%02x'):format(n))
+      _with_0:write(n == 255 and '\n' or n % 8 == 7 and ',\n' or ', ')
+    end
+  end
+  _with_0:write([[	};
+#endif
+	pc = u->ram.ptr;
+	wptr = u->wst.ptr;
+	rptr = u->rst.ptr;
+#ifdef THREADED_DISPATCH
+	NEXT;
+	{
+		{
+#else
+	while((instr = u->ram.dat[pc++])) {
 		switch(instr) {
+#endif
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-value"
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -343,7 +490,9 @@ uxn_eval(Uxn *u, Uint16 vec)
       local _list_0 = allops[i].n
       for _index_0 = 1, #_list_0 do
         local n = _list_0[_index_0]
-        _with_0:write(('\t\tcase 0x%02x: /* %s */\n'):format(n, allops[n + 1].name))
+        if n ~= 0x00 then
+          _with_0:write(('\t\tCASE(0x%02x) /* %s */\n'):format(n, allops[n + 1].name))
+        end
       end
       if generate_labels then
         _with_0:write(('\t\t\t__asm__("evaluxn_%02x_%s:");\n'):format(allops[i].n[1], allops[i].name))
@@ -358,9 +507,23 @@ uxn_eval(Uxn *u, Uint16 vec)
   _with_0:write([[#pragma GCC diagnostic pop
 		}
 	}
+#ifdef THREADED_DISPATCH
+brk:
+#endif
+	u->ram.ptr = pc;
+	u->wst.ptr = wptr;
+	u->rst.ptr = rptr;
 	return 1;
+suspend:
+	u->ram.ptr = pc;
+	u->wst.ptr = wptr;
+	u->rst.ptr = rptr;
+	return UXN_SUSPENDED;
 #ifndef NO_STACK_CHECKS
 error:
+	u->ram.ptr = pc;
+	u->wst.ptr = wptr;
+	u->rst.ptr = rptr;
 	if(u->wst.error)
 		return uxn_halt(u, u->wst.error, "Working-stack", instr);
 	else
@@ -0,0 +1,24 @@
+#!/bin/sh
+set -e
+cd "$(dirname "${0}")/.."
+rm -rf reentrant-test
+mkdir reentrant-test
+
+# each rom runs on 64 machines at once, one per thread, and must end up
+# exactly as it does when run alone
+
+echo 'Building src/uxn.c with etc/uxn-state.c'
+cc -std=c89 -Wall -Wno-unknown-pragmas -DNDEBUG -O2 -Isrc etc/uxn-state.c src/uxn.c -lpthread -o reentrant-test/uxn-state
+FAILED=0
+for F in examples/demos/fizzbuzz examples/demos/automata examples/demos/prng software/neralie software/calc software/repl; do
+	B="$(basename "${F}")"
+	bin/uxnasm "projects/${F}.tal" "reentrant-test/${B}.rom" > /dev/null 2>&1 || { echo "error: uxnasm failed on ${F}"; exit 1; }
+	if ! reentrant-test/uxn-state -t 64 "reentrant-test/${B}.rom" > /dev/null 2> reentrant-test/state.log; then
+		echo "error: ${B} differs when run on 64 threads"
+		cat reentrant-test/state.log
+		FAILED=1
+	fi
+done
+[ "${FAILED}" = 0 ]
+rm -rf reentrant-test
+echo 'All OK'
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "uxn.h"
+
+/*
+Copyright (c) 2021 Devine Lu Linvega
+
+Permission to use, copy, modify, and distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE.
+*/
+
+/*
+Runs a rom without a screen, feeds every device vector the same series of
+events, and prints a hash of the memory, the stacks and what was written to
+the devices, to compare cores and builds:
+
+	cc -Isrc etc/uxn-state.c src/uxn.c -lpthread -o bin/uxn-state
+	bin/uxn-state [-t threads] bin/life.rom
+
+Given -t, the rom is also run on that many machines at once, one per thread,
+and the run fails when any of them ends up unlike the first.
+*/
+
+#define EVENTS 300
+
+typedef struct {
+	Uxn u; /* first, devices find their machine through it */
+	unsigned long out;
+	int halts;
+} Machine;
+
+static Uint8 rom[0x10000 - PAGE_PROGRAM];
+static long romlen;
+
+int
+uxn_halt(Uxn *u, Uint8 error, char *name, int id)
+{
+	(void)error;
+	(void)name;
+	(void)id;
+	((Machine *)u)->halts++;
+	return 0;
+}
+
+static int
+system_talk(Device *d, Uint8 b0, Uint8 w)
+{
+	if(!w) {
+		d->dat[0x2] = d->u->wst.ptr;
+		d->dat[0x3] = d->u->rst.ptr;
+	} else if(b0 == 0x2)
+		d->u->wst.ptr = d->dat[0x2];
+	else if(b0 == 0x3)
+		d->u->rst.ptr = d->dat[0x3];
+	return 1;
+}
+
+static int
+any_talk(Device *d, Uint8 b0, Uint8 w)
+{
+	Machine *m = (Machine *)d->u;
+	if(w) {
+		if(b0 == 0x1)
+			d->vector = peek16(d->dat, 0x0);
+		m->out = m->out * 31 + d->dat[b0] + b0;
+	}
+	return 1;
+}
+
+static unsigned long
+hash(Uint8 *p, long n)
+{
+	unsigned long h = 5381;
+	while(n--)
+		h = h * 33 + *p++;
+	return h;
+}
+
+static void *
+run(void *arg)
+{
+	Machine *m = arg;
+	Uxn *u = &m->u;
+	int i, k;
+	m->out = m->halts = 0;
+	uxn_boot(u);
+	memcpy(u->ram.dat + PAGE_PROGRAM, rom, romlen);
+	for(k = 1; k < 16; k++)
+		uxn_port(u, k, any_talk);
+	uxn_port(u, 0x0, system_talk);
+	uxn_eval(u, PAGE_PROGRAM);
+	for(i = 0; i < EVENTS; i++)
+		for(k = 1; k < 16; k++) {
+			u->dev[k].dat[0x2] = "hello world\n"[i % 12];
+			if(!(i % 7))
+				u->dev[k].dat[0x3] = i;
+			uxn_eval(u, u->dev[k].vector);
+		}
+	return NULL;
+}
+
+static void
+state(Machine *m, char *s)
+{
+	Uxn *u = &m->u;
+	sprintf(s, "%08lx %08lx %08lx %02x %02x %d %08lx",
+		hash(u->ram.dat, sizeof(u->ram.dat)) & 0xffffffff,
+		hash(u->wst.dat, u->wst.ptr) & 0xffffffff,
+		hash(u->rst.dat, u->rst.ptr) & 0xffffffff,
+		u->wst.ptr,
+		u->rst.ptr,
+		m->halts,
+		m->out & 0xffffffff);
+}
+
+int
+main(int argc, char *argv[])
+{
+	Machine *m;
+	pthread_t *threads;
+	char first[0x80], other[0x80];
+	int i, n = 0, differ = 0;
+	FILE *f;
+	if(argc == 4 && !strcmp(argv[1], "-t"))
+		n = atoi(argv[2]), argv += 2, argc -= 2;
+	if(argc != 2 || n < 0)
+		return fprintf(stderr, "usage: %s [-t threads] file.rom\n", argv[0]), 1;
+	if(!(f = fopen(argv[1], "rb")))
+		return fprintf(stderr, "Load: Failed %s\n", argv[1]), 1;
+	romlen = fread(rom, 1, sizeof(rom), f);
+	fclose(f);
+	if(!(m = malloc((n + 1) * sizeof(Machine))) || !(threads = malloc((n + 1) * sizeof(pthread_t))))
+		return fprintf(stderr, "Run: Out of memory\n"), 1;
+	run(&m[0]);
+	state(&m[0], first);
+	for(i = 1; i <= n; i++)
+		if(pthread_create(&threads[i], NULL, run, &m[i]))
+			return fprintf(stderr, "Run: Thread %d failed\n", i), 1;
+	for(i = 1; i <= n; i++) {
+		pthread_join(threads[i], NULL);
+		state(&m[i], other);
+		differ += !!strcmp(first, other);
+	}
+	printf("%s\n", first);
+	if(differ)
+		fprintf(stderr, "%d of %d machines differ from a lone run\n", differ, n);
+	return !!differ;
+}
@@ -0,0 +1,172 @@
+#define _DEFAULT_SOURCE
+#define _FILE_OFFSET_BITS 64
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "../uxn.h"
+#include "file.h"
+
+/*
+Copyright (c) 2021 Devine Lu Linvega
+
+Permission to use, copy, modify, and distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE.
+*/
+
+#define IDLE 2 /* seconds before an unused file is closed */
+#define AHEAD 0x100000 /* bytes asked for ahead of sequential loads */
+
+static void
+release(FileHandle *h)
+{
+	if(h->fd >= 0)
+		close(h->fd);
+	free(h->name);
+	h->fd = -1, h->name = NULL;
+}
+
+static void
+sweep(Files *f, time_t t)
+{
+	int i;
+	for(i = 0; i < FILE_HANDLES; i++)
+		if(f->handles[i].fd >= 0 && t - f->handles[i].used > IDLE)
+			release(&f->handles[i]);
+}
+
+/* a handle is used again only while the name still leads to the same file,
+   saves append unless they start the file over */
+
+static FileHandle *
+handle(Files *f, char *name, int save)
+{
+	struct stat st;
+	FileHandle *h, *lru = &f->handles[0];
+	time_t t = time(NULL);
+	int i, found = !stat(name, &st);
+	sweep(f, t);
+	for(i = 0; i < FILE_HANDLES; i++) {
+		h = &f->handles[i];
+		if(h->fd >= 0 && h->save == save && !strcmp(h->name, name)) {
+			if(found && h->dev == st.st_dev && h->ino == st.st_ino) {
+				h->used = t, h->size = st.st_size;
+				return h;
+			}
+			release(h); /* renamed or deleted since */
+		}
+		if(lru->fd >= 0 && (h->fd < 0 || h->used < lru->used))
+			lru = h;
+	}
+	if(!found && !save)
+		return NULL;
+	release(lru);
+	if((lru->fd = open(name, save ? O_WRONLY | O_CREAT | O_APPEND : O_RDONLY, 0666)) < 0)
+		return NULL;
+	if(fstat(lru->fd, &st) || !(lru->name = malloc(strlen(name) + 1))) {
+		release(lru);
+		return NULL;
+	}
+	strcpy(lru->name, name);
+	lru->save = save, lru->dev = st.st_dev, lru->ino = st.st_ino, lru->used = t;
+	lru->size = st.st_size, lru->next = -1, lru->streak = 0, lru->ahead = 0;
+	return lru;
+}
+
+/* the third load in a row that starts where the last one ended has the
+   kernel read the next megabyte while this one is copied. Loads go through
+   pread, so a file cut short meanwhile gives a short read, not a fault */
+
+static long
+fetch(FileHandle *h, Uint8 *dst, long len, off_t offset)
+{
+	h->streak = offset == h->next ? h->streak + 1 : 0;
+	h->next = offset + len;
+#ifdef POSIX_FADV_WILLNEED
+	if(!h->streak)
+		h->ahead = 0;
+	else if(h->streak >= 2 && offset >= 0) {
+		if(h->streak == 2)
+			posix_fadvise(h->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+		if(h->ahead < offset)
+			h->ahead = offset / AHEAD * AHEAD;
+		if(h->ahead < h->size && h->ahead < offset + len + AHEAD) {
+			posix_fadvise(h->fd, h->ahead, AHEAD, POSIX_FADV_WILLNEED);
+			h->ahead += AHEAD;
+		}
+	}
+#endif
+	return pread(h->fd, dst, len, offset);
+}
+
+/* the offset is 64 bits, ports 0x0-0x3 of the device after datetime hold
+   its top half. While port 0x4 is set, loads move the offset past what they
+   read and saves append whatever the offset */
+
+static off_t
+fileoffset(Uint8 *x, Uint8 *d)
+{
+	if(x[0x0] & 0x80)
+		return -1;
+	return (off_t)peek16(x, 0x0) << 48 | (off_t)peek16(x, 0x2) << 32 | (off_t)peek16(d, 0x4) << 16 | peek16(d, 0x6);
+}
+
+static void
+fileseek(Uint8 *x, Uint8 *d, off_t o)
+{
+	poke16(x, 0x0, o >> 48);
+	poke16(x, 0x2, o >> 32);
+	poke16(d, 0x4, o >> 16);
+	poke16(d, 0x6, o);
+}
+
+void
+file_access(Files *f, Device *d, Uint8 b0)
+{
+	Uint8 read = b0 == 0xd;
+	if(read || b0 == 0xf) {
+		char *name = (char *)&d->mem[peek16(d->dat, 0x8)];
+		Uint16 length = peek16(d->dat, 0xa);
+		Uint8 *x = d->u->dev[0xc].dat;
+		off_t at = fileoffset(x, d->dat);
+		long result = -1;
+		Uint16 addr = peek16(d->dat, b0 - 1);
+		FileHandle *h = handle(f, name, !read);
+		if(addr + length > 0x10000)
+			length = 0x10000 - addr;
+		if(h && read)
+			result = fetch(h, &d->mem[addr], length, at);
+		else if(h && (at || x[0x4] || !ftruncate(h->fd, 0)))
+			result = write(h->fd, &d->mem[addr], length);
+		poke16(d->dat, 0x2, result > 0 ? result : 0);
+		if(read && result > 0 && x[0x4])
+			fileseek(x, d->dat, at + result);
+	}
+}
+
+void
+file_init(Files *f)
+{
+	int i;
+	for(i = 0; i < FILE_HANDLES; i++)
+		f->handles[i].fd = -1, f->handles[i].name = NULL;
+}
+
+void
+file_sweep(Files *f)
+{
+	sweep(f, time(NULL));
+}
+
+void
+file_close(Files *f)
+{
+	int i;
+	for(i = 0; i < FILE_HANDLES; i++)
+		release(&f->handles[i]);
+}
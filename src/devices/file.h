@@ -0,0 +1,37 @@
+#include <sys/types.h>
+#include <time.h>
+
+/*
+Copyright (c) 2021 Devine Lu Linvega
+
+Permission to use, copy, modify, and distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE.
+*/
+
+/* the file device, shared by src/uxncli.c and src/uxnemu.c. Include after
+   uxn.h, and build with _FILE_OFFSET_BITS 64 so that off_t agrees */
+
+#define FILE_HANDLES 4
+
+/* a file opened by the file device, kept for the next load or save */
+typedef struct {
+	char *name;
+	int fd, save, streak;
+	dev_t dev;
+	ino_t ino;
+	time_t used;
+	off_t size, next, ahead; /* ahead, what the kernel was asked to read */
+} FileHandle;
+
+typedef struct {
+	FileHandle handles[FILE_HANDLES];
+} Files;
+
+void file_init(Files *f);
+void file_sweep(Files *f); /* closes the files left unused for a while */
+void file_close(Files *f);
+void file_access(Files *f, Device *d, Uint8 b0); /* port b0 was written to */
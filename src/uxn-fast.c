@@ -22,416 +22,620 @@ See etc/mkuxn-fast.moon for instructions.
 
 */
 
+#define MODE_SHORT 0x20
 #define MODE_RETURN 0x40
 #define MODE_KEEP 0x80
 
 #pragma mark - Operations
 
 /* clang-format off */
-static void   poke8(Uint8 *m, Uint16 a, Uint8 b) { m[a] = b; }
-static Uint8  peek8(Uint8 *m, Uint16 a) { return m[a]; }
-static int    devw8(Device *d, Uint8 a, Uint8 b) { d->dat[a & 0xf] = b; return d->talk(d, a & 0x0f, 1); }
-static Uint8  devr8(Device *d, Uint8 a) { d->talk(d, a & 0x0f, 0); return d->dat[a & 0xf];  }
+static void   poke8(Uint8 *m, Uint16 a, Uint16 b) { m[a] = b; }
+static Uint16 peek8(Uint8 *m, Uint16 a) { return m[a]; }
+static int    devw8(Device *d, Uint8 a, Uint16 b) { d->dat[a & 0xf] = b; return d->talk(d, a & 0x0f, 1); }
+static Uint16 devr8(Device *d, Uint8 a) { d->talk(d, a & 0x0f, 0); return d->dat[a & 0xf];  }
 void   poke16(Uint8 *m, Uint16 a, Uint16 b) { poke8(m, a, b >> 8); poke8(m, a + 1, b); }
 Uint16 peek16(Uint8 *m, Uint16 a) { return (peek8(m, a) << 8) + peek8(m, a + 1); }
 static int    devw16(Device *d, Uint8 a, Uint16 b) { return devw8(d, a, b >> 8) && devw8(d, a + 1, b); }
 
 /* clang-format on */
 
+#ifdef THREADED_DISPATCH
+#define CASE(n) op_##n:
+#define NEXT goto *dispatch[(instr = u->ram.dat[pc++])]
+#else
+#define CASE(n) case n:
+#define NEXT break
+#endif
+
 #pragma mark - Core
 
 int
-uxn_eval(Uxn *u, Uint16 vec)
+uxn_resume(Uxn *u, unsigned int steps)
 {
-	Uint8 instr;
-	if(!vec || u->dev[0].dat[0xf]) 
-		return 0;
-	u->ram.ptr = vec;
-	if(u->wst.ptr > 0xf8) u->wst.ptr = 0xf8;
-	while((instr = u->ram.dat[u->ram.ptr++])) {
+	Uint8 instr, wptr, rptr;
+	Uint16 pc;
+#ifdef THREADED_DISPATCH
+	static void *dispatch[] = {
+		&&brk, &&op_0x01, &&op_0x02, &&op_0x03, &&op_0x04, &&op_0x05, &&op_0x06, &&op_0x07,
+		&&op_0x08, &&op_0x09, &&op_0x0a, &&op_0x0b, &&op_0x0c, &&op_0x0d, &&op_0x0e, &&op_0x0f,
+		&&op_0x10, &&op_0x11, &&op_0x12, &&op_0x13, &&op_0x14, &&op_0x15, &&op_0x16, &&op_0x17,
+		&&op_0x18, &&op_0x19, &&op_0x1a, &&op_0x1b, &&op_0x1c, &&op_0x1d, &&op_0x1e, &&op_0x1f,
+		&&op_0x20, &&op_0x21, &&op_0x22, &&op_0x23, &&op_0x24, &&op_0x25, &&op_0x26, &&op_0x27,
+		&&op_0x28, &&op_0x29, &&op_0x2a, &&op_0x2b, &&op_0x2c, &&op_0x2d, &&op_0x2e, &&op_0x2f,
+		&&op_0x30, &&op_0x31, &&op_0x32, &&op_0x33, &&op_0x34, &&op_0x35, &&op_0x36, &&op_0x37,
+		&&op_0x38, &&op_0x39, &&op_0x3a, &&op_0x3b, &&op_0x3c, &&op_0x3d, &&op_0x3e, &&op_0x3f,
+		&&op_0x40, &&op_0x41, &&op_0x42, &&op_0x43, &&op_0x44, &&op_0x45, &&op_0x46, &&op_0x47,
+		&&op_0x48, &&op_0x49, &&op_0x4a, &&op_0x4b, &&op_0x4c, &&op_0x4d, &&op_0x4e, &&op_0x4f,
+		&&op_0x50, &&op_0x51, &&op_0x52, &&op_0x53, &&op_0x54, &&op_0x55, &&op_0x56, &&op_0x57,
+		&&op_0x58, &&op_0x59, &&op_0x5a, &&op_0x5b, &&op_0x5c, &&op_0x5d, &&op_0x5e, &&op_0x5f,
+		&&op_0x60, &&op_0x61, &&op_0x62, &&op_0x63, &&op_0x64, &&op_0x65, &&op_0x66, &&op_0x67,
+		&&op_0x68, &&op_0x69, &&op_0x6a, &&op_0x6b, &&op_0x6c, &&op_0x6d, &&op_0x6e, &&op_0x6f,
+		&&op_0x70, &&op_0x71, &&op_0x72, &&op_0x73, &&op_0x74, &&op_0x75, &&op_0x76, &&op_0x77,
+		&&op_0x78, &&op_0x79, &&op_0x7a, &&op_0x7b, &&op_0x7c, &&op_0x7d, &&op_0x7e, &&op_0x7f,
+		&&op_0x80, &&op_0x81, &&op_0x82, &&op_0x83, &&op_0x84, &&op_0x85, &&op_0x86, &&op_0x87,
+		&&op_0x88, &&op_0x89, &&op_0x8a, &&op_0x8b, &&op_0x8c, &&op_0x8d, &&op_0x8e, &&op_0x8f,
+		&&op_0x90, &&op_0x91, &&op_0x92, &&op_0x93, &&op_0x94, &&op_0x95, &&op_0x96, &&op_0x97,
+		&&op_0x98, &&op_0x99, &&op_0x9a, &&op_0x9b, &&op_0x9c, &&op_0x9d, &&op_0x9e, &&op_0x9f,
+		&&op_0xa0, &&op_0xa1, &&op_0xa2, &&op_0xa3, &&op_0xa4, &&op_0xa5, &&op_0xa6, &&op_0xa7,
+		&&op_0xa8, &&op_0xa9, &&op_0xaa, &&op_0xab, &&op_0xac, &&op_0xad, &&op_0xae, &&op_0xaf,
+		&&op_0xb0, &&op_0xb1, &&op_0xb2, &&op_0xb3, &&op_0xb4, &&op_0xb5, &&op_0xb6, &&op_0xb7,
+		&&op_0xb8, &&op_0xb9, &&op_0xba, &&op_0xbb, &&op_0xbc, &&op_0xbd, &&op_0xbe, &&op_0xbf,
+		&&op_0xc0, &&op_0xc1, &&op_0xc2, &&op_0xc3, &&op_0xc4, &&op_0xc5, &&op_0xc6, &&op_0xc7,
+		&&op_0xc8, &&op_0xc9, &&op_0xca, &&op_0xcb, &&op_0xcc, &&op_0xcd, &&op_0xce, &&op_0xcf,
+		&&op_0xd0, &&op_0xd1, &&op_0xd2, &&op_0xd3, &&op_0xd4, &&op_0xd5, &&op_0xd6, &&op_0xd7,
+		&&op_0xd8, &&op_0xd9, &&op_0xda, &&op_0xdb, &&op_0xdc, &&op_0xdd, &&op_0xde, &&op_0xdf,
+		&&op_0xe0, &&op_0xe1, &&op_0xe2, &&op_0xe3, &&op_0xe4, &&op_0xe5, &&op_0xe6, &&op_0xe7,
+		&&op_0xe8, &&op_0xe9, &&op_0xea, &&op_0xeb, &&op_0xec, &&op_0xed, &&op_0xee, &&op_0xef,
+		&&op_0xf0, &&op_0xf1, &&op_0xf2, &&op_0xf3, &&op_0xf4, &&op_0xf5, &&op_0xf6, &&op_0xf7,
+		&&op_0xf8, &&op_0xf9, &&op_0xfa, &&op_0xfb, &&op_0xfc, &&op_0xfd, &&op_0xfe, &&op_0xff
+	};
+#endif
+	pc = u->ram.ptr;
+	wptr = u->wst.ptr;
+	rptr = u->rst.ptr;
+#ifdef THREADED_DISPATCH
+	NEXT;
+	{
+		{
+#else
+	while((instr = u->ram.dat[pc++])) {
 		switch(instr) {
+#endif
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-value"
 #pragma GCC diagnostic ignored "-Wunused-variable"
-		case 0x00: /* LIT */
-		case 0x80: /* LITk */
-			{
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, u->ram.ptr++);
+		CASE(0x80) /* LITk */
+			if(u->ram.dat[(Uint16)(pc + 1)] == 0x0d) { /* JCN */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2);
+				if(u->wst.dat[wptr - 1]) {
+					pc += (Sint8)a;
+					steps--;
+				}
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x0d;
+					goto error;
+				}
+#endif
+				wptr -= 1;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x1c) { /* AND */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2), b = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = b & a;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x1c;
+					goto error;
+				}
+#endif
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x0c) { /* JMP */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2);
+				pc += (Sint8)a;
+				steps--;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x0e) { /* JSR */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2);
+				u->rst.dat[rptr] = pc >> 8;
+				u->rst.dat[rptr + 1] = pc & 0xff;
+				pc += (Sint8)a;
+				steps--;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(rptr > 253, 0)) {
+					u->rst.error = 2;
+					instr = 0x0e;
+					goto error;
+				}
+#endif
+				rptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x17) { /* DEO */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2), b = u->wst.dat[wptr - 1];
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x17;
+					goto error;
+				}
+#endif
+				wptr -= 1;
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw8(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x05) { /* SWP */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2), b = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = a;
+				u->wst.dat[wptr] = b;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x05;
+					goto error;
+				}
+				if(__builtin_expect(wptr > 254, 0)) {
+					u->wst.error = 2;
+					instr = 0x05;
+					goto error;
+				}
+#endif
+				wptr += 1;
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x3f) { /* SFT2 */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2);
+				Uint16 b = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr - 2] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
+				u->wst.dat[wptr - 1] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 2, 0)) {
+					u->wst.error = 1;
+					instr = 0x3f;
+					goto error;
+				}
+#endif
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x1f) { /* SFT */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2), b = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = b >> (a & 0x0f) << ((a & 0xf0) >> 4);
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x1f;
+					goto error;
+				}
+#endif
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x0b) { /* LTH */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2), b = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = b < a;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x0b;
+					goto error;
+				}
+#endif
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x19) { /* SUB */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2), b = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = b - a;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x19;
+					goto error;
+				}
+#endif
+			} else if(u->ram.dat[(Uint16)(pc + 1)] == 0x18) { /* ADD */
+				Uint8 a = peek8(u->ram.dat, (pc += 2) - 2), b = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = b + a;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 1, 0)) {
+					u->wst.error = 1;
+					instr = 0x18;
+					goto error;
+				}
+#endif
+			} else {
+				u->wst.dat[wptr] = peek8(u->ram.dat, pc++);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x01: /* INC */
+			NEXT;
+		CASE(0x01) /* INC */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 1] = a + 1;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = a + 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x02: /* POP */
+			NEXT;
+		CASE(0x02) /* POP */
 			{
-				u->wst.dat[u->wst.ptr - 1];
+				u->wst.dat[wptr - 1];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x03: /* DUP */
+			NEXT;
+		CASE(0x03) /* DUP */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x04: /* NIP */
+			NEXT;
+		CASE(0x04) /* NIP */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x05: /* SWP */
+			NEXT;
+		CASE(0x05) /* SWP */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = a;
-				u->wst.dat[u->wst.ptr - 1] = b;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = a;
+				u->wst.dat[wptr - 1] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x06: /* OVR */
+			NEXT;
+		CASE(0x06) /* OVR */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x07: /* ROT */
+			NEXT;
+		CASE(0x07) /* ROT */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3];
-				u->wst.dat[u->wst.ptr - 3] = b;
-				u->wst.dat[u->wst.ptr - 2] = a;
-				u->wst.dat[u->wst.ptr - 1] = c;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3];
+				u->wst.dat[wptr - 3] = b;
+				u->wst.dat[wptr - 2] = a;
+				u->wst.dat[wptr - 1] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x08: /* EQU */
+			NEXT;
+		CASE(0x08) /* EQU */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b == a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x09: /* NEQ */
+			NEXT;
+		CASE(0x09) /* NEQ */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b != a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x0a: /* GTH */
+			NEXT;
+		CASE(0x0a) /* GTH */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b > a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x0b: /* LTH */
+			NEXT;
+		CASE(0x0b) /* LTH */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b < a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x0c: /* JMP */
+			NEXT;
+		CASE(0x0c) /* JMP */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x0d: /* JCN */
+			NEXT;
+		CASE(0x0d) /* JCN */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				if(u->wst.dat[u->wst.ptr - 2]) u->ram.ptr += (Sint8)a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				if(u->wst.dat[wptr - 2]) {
+					pc += (Sint8)a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x0e: /* JSR */
+			NEXT;
+		CASE(0x0e) /* JSR */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = u->ram.ptr >> 8;
-				u->rst.dat[u->rst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->rst.dat[rptr] = pc >> 8;
+				u->rst.dat[rptr + 1] = pc & 0xff;
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x0f: /* STH */
+			NEXT;
+		CASE(0x0f) /* STH */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->rst.dat[rptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x10: /* LDZ */
+			NEXT;
+		CASE(0x10) /* LDZ */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 1] = peek8(u->ram.dat, a);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x11: /* STZ */
+			NEXT;
+		CASE(0x11) /* STZ */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint8 b = u->wst.dat[u->wst.ptr - 2];
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x12: /* LDR */
+			NEXT;
+		CASE(0x12) /* LDR */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 1] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = peek8(u->ram.dat, pc + (Sint8)a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x13: /* STR */
+			NEXT;
+		CASE(0x13) /* STR */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint8 b = u->wst.dat[u->wst.ptr - 2];
-				poke8(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				poke8(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x14: /* LDA */
+			NEXT;
+		CASE(0x14) /* LDA */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				u->wst.dat[u->wst.ptr - 2] = peek8(u->ram.dat, a);
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr - 2] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x15: /* STA */
+			NEXT;
+		CASE(0x15) /* STA */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				Uint8 b = u->wst.dat[u->wst.ptr - 3];
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				Uint8 b = u->wst.dat[wptr - 3];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
 			}
-			break;
-		case 0x16: /* DEI */
+			NEXT;
+		CASE(0x16) /* DEI */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 1] = devr8(&u->dev[a >> 4], a);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->wst.dat[wptr - 1] = devr8(&u->dev[a >> 4], a);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x17: /* DEO */
+			NEXT;
+		CASE(0x17) /* DEO */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				if(!devw8(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw8(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0x18: /* ADD */
+			NEXT;
+		CASE(0x18) /* ADD */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b + a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b + a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x19: /* SUB */
+			NEXT;
+		CASE(0x19) /* SUB */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b - a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b - a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x1a: /* MUL */
+			NEXT;
+		CASE(0x1a) /* MUL */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b * a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b * a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x1b: /* DIV */
+			NEXT;
+		CASE(0x1b) /* DIV */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
 				if(a == 0) {
 					u->wst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -439,478 +643,557 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->wst.dat[u->wst.ptr - 2] = b / a;
+				u->wst.dat[wptr - 2] = b / a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x1c: /* AND */
+			NEXT;
+		CASE(0x1c) /* AND */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b & a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x1d: /* ORA */
+			NEXT;
+		CASE(0x1d) /* ORA */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b | a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x1e: /* EOR */
+			NEXT;
+		CASE(0x1e) /* EOR */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b ^ a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x1f: /* SFT */
+			NEXT;
+		CASE(0x1f) /* SFT */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr - 2] = b >> (a & 0x07) << ((a & 0x70) >> 4);
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr - 2] = b >> (a & 0x0f) << ((a & 0xf0) >> 4);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x20: /* LIT2 */
-		case 0xa0: /* LIT2k */
-			{
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, u->ram.ptr++);
-				u->wst.dat[u->wst.ptr + 1] = peek8(u->ram.dat, u->ram.ptr++);
+			NEXT;
+		CASE(0x20) /* LIT2 */
+		CASE(0xa0) /* LIT2k */
+			if(u->ram.dat[(Uint16)(pc + 2)] == 0x38) { /* ADD2 */
+				Uint16 a = peek16(u->ram.dat, (pc += 3) - 3), b = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr - 2] = (b + a) >> 8;
+				u->wst.dat[wptr - 1] = (b + a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
+					u->wst.error = 1;
+					instr = 0x38;
+					goto error;
+				}
+#endif
+			} else if(u->ram.dat[(Uint16)(pc + 2)] == 0x35) { /* STA2 */
+				Uint16 a = peek16(u->ram.dat, (pc += 3) - 3), b = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				poke16(u->ram.dat, a, b);
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr < 2, 0)) {
+					u->wst.error = 1;
+					instr = 0x35;
+					goto error;
+				}
+#endif
+				wptr -= 2;
+			} else if(u->ram.dat[(Uint16)(pc + 2)] == 0x34) { /* LDA2 */
+				Uint16 a = peek16(u->ram.dat, (pc += 3) - 3);
+				u->wst.dat[wptr] = peek8(u->ram.dat, a);
+				u->wst.dat[wptr + 1] = peek8(u->ram.dat, a + 1);
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
+					instr = 0x34;
+					goto error;
+				}
+#endif
+				wptr += 2;
+			} else if(u->ram.dat[(Uint16)(pc + 2)] == 0x2e) { /* JSR2 */
+				Uint16 a = peek16(u->ram.dat, (pc += 3) - 3);
+				u->rst.dat[rptr] = pc >> 8;
+				u->rst.dat[rptr + 1] = pc & 0xff;
+				pc = a;
+				steps--;
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(rptr > 253, 0)) {
+					u->rst.error = 2;
+					instr = 0x2e;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				rptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
+			} else if(u->ram.dat[(Uint16)(pc + 2)] == 0x2c) { /* JMP2 */
+				Uint16 a = peek16(u->ram.dat, (pc += 3) - 3);
+				pc = a;
+				steps--;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
+			} else {
+				u->wst.dat[wptr] = peek8(u->ram.dat, pc++);
+				u->wst.dat[wptr + 1] = peek8(u->ram.dat, pc++);
+#ifndef NO_STACK_CHECKS
+				if(__builtin_expect(wptr > 253, 0)) {
+					u->wst.error = 2;
+					goto error;
+				}
+#endif
+				wptr += 2;
 			}
-			break;
-		case 0x21: /* INC2 */
+			NEXT;
+		CASE(0x21) /* INC2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				u->wst.dat[u->wst.ptr - 2] = (a + 1) >> 8;
-				u->wst.dat[u->wst.ptr - 1] = (a + 1) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr - 2] = (a + 1) >> 8;
+				u->wst.dat[wptr - 1] = (a + 1) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x22: /* POP2 */
+			NEXT;
+		CASE(0x22) /* POP2 */
 			{
-				(u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
+				(u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x23: /* DUP2 */
+			NEXT;
+		CASE(0x23) /* DUP2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b;
-				u->wst.dat[u->wst.ptr + 1] = a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b;
+				u->wst.dat[wptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0x24: /* NIP2 */
+			NEXT;
+		CASE(0x24) /* NIP2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				(u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = a >> 8;
-				u->wst.dat[u->wst.ptr - 3] = a & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				(u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = a >> 8;
+				u->wst.dat[wptr - 3] = a & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x25: /* SWP2 */
+			NEXT;
+		CASE(0x25) /* SWP2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr - 4] = b;
-				u->wst.dat[u->wst.ptr - 3] = a;
-				u->wst.dat[u->wst.ptr - 2] = d;
-				u->wst.dat[u->wst.ptr - 1] = c;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr - 4] = b;
+				u->wst.dat[wptr - 3] = a;
+				u->wst.dat[wptr - 2] = d;
+				u->wst.dat[wptr - 1] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x26: /* OVR2 */
+			NEXT;
+		CASE(0x26) /* OVR2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr] = d;
-				u->wst.dat[u->wst.ptr + 1] = c;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr] = d;
+				u->wst.dat[wptr + 1] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0x27: /* ROT2 */
+			NEXT;
+		CASE(0x27) /* ROT2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4], e = u->wst.dat[u->wst.ptr - 5], f = u->wst.dat[u->wst.ptr - 6];
-				u->wst.dat[u->wst.ptr - 6] = d;
-				u->wst.dat[u->wst.ptr - 5] = c;
-				u->wst.dat[u->wst.ptr - 4] = b;
-				u->wst.dat[u->wst.ptr - 3] = a;
-				u->wst.dat[u->wst.ptr - 2] = f;
-				u->wst.dat[u->wst.ptr - 1] = e;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4], e = u->wst.dat[wptr - 5], f = u->wst.dat[wptr - 6];
+				u->wst.dat[wptr - 6] = d;
+				u->wst.dat[wptr - 5] = c;
+				u->wst.dat[wptr - 4] = b;
+				u->wst.dat[wptr - 3] = a;
+				u->wst.dat[wptr - 2] = f;
+				u->wst.dat[wptr - 1] = e;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 6, 0)) {
+				if(__builtin_expect(wptr < 6, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x28: /* EQU2 */
+			NEXT;
+		CASE(0x28) /* EQU2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = b == a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
 			}
-			break;
-		case 0x29: /* NEQ2 */
+			NEXT;
+		CASE(0x29) /* NEQ2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = b != a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
 			}
-			break;
-		case 0x2a: /* GTH2 */
+			NEXT;
+		CASE(0x2a) /* GTH2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = b > a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
 			}
-			break;
-		case 0x2b: /* LTH2 */
+			NEXT;
+		CASE(0x2b) /* LTH2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = b < a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
 			}
-			break;
-		case 0x2c: /* JMP2 */
+			NEXT;
+		CASE(0x2c) /* JMP2 */
 			{
-				u->ram.ptr = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x2d: /* JCN2 */
+			NEXT;
+		CASE(0x2d) /* JCN2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				if(u->wst.dat[u->wst.ptr - 3]) u->ram.ptr = a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				if(u->wst.dat[wptr - 3]) {
+					pc = a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x2e: /* JSR2 */
+			NEXT;
+		CASE(0x2e) /* JSR2 */
 			{
-				u->rst.dat[u->rst.ptr] = u->ram.ptr >> 8;
-				u->rst.dat[u->rst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->rst.dat[rptr] = pc >> 8;
+				u->rst.dat[rptr + 1] = pc & 0xff;
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x2f: /* STH2 */
+			NEXT;
+		CASE(0x2f) /* STH2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b;
-				u->rst.dat[u->rst.ptr + 1] = a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->rst.dat[rptr] = b;
+				u->rst.dat[rptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0x30: /* LDZ2 */
+			NEXT;
+		CASE(0x30) /* LDZ2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 1] = peek8(u->ram.dat, a);
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, a + 1);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = peek8(u->ram.dat, a);
+				u->wst.dat[wptr] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x31: /* STZ2 */
+			NEXT;
+		CASE(0x31) /* STZ2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
 			}
-			break;
-		case 0x32: /* LDR2 */
+			NEXT;
+		CASE(0x32) /* LDR2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 1] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a + 1);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 1] = peek8(u->ram.dat, pc + (Sint8)a);
+				u->wst.dat[wptr] = peek8(u->ram.dat, pc + (Sint8)a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x33: /* STR2 */
+			NEXT;
+		CASE(0x33) /* STR2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
-				poke16(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
+				poke16(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
 			}
-			break;
-		case 0x34: /* LDA2 */
+			NEXT;
+		CASE(0x34) /* LDA2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				u->wst.dat[u->wst.ptr - 2] = peek8(u->ram.dat, a);
-				u->wst.dat[u->wst.ptr - 1] = peek8(u->ram.dat, a + 1);
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr - 2] = peek8(u->ram.dat, a);
+				u->wst.dat[wptr - 1] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x35: /* STA2 */
+			NEXT;
+		CASE(0x35) /* STA2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				Uint16 b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 4;
+				wptr -= 4;
 			}
-			break;
-		case 0x36: /* DEI2 */
+			NEXT;
+		CASE(0x36) /* DEI2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 1] = devr8(&u->dev[a >> 4], a);
-				u->wst.dat[u->wst.ptr] = devr8(&u->dev[a >> 4], a + 1);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->wst.dat[wptr - 1] = devr8(&u->dev[a >> 4], a);
+				u->wst.dat[wptr] = devr8(&u->dev[a >> 4], a + 1);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x37: /* DEO2 */
+			NEXT;
+		CASE(0x37) /* DEO2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
-				if(!devw16(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 3;
+				wptr -= 3;
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw16(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0x38: /* ADD2 */
+			NEXT;
+		CASE(0x38) /* ADD2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = (b + a) >> 8;
-				u->wst.dat[u->wst.ptr - 3] = (b + a) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = (b + a) >> 8;
+				u->wst.dat[wptr - 3] = (b + a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x39: /* SUB2 */
+			NEXT;
+		CASE(0x39) /* SUB2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = (b - a) >> 8;
-				u->wst.dat[u->wst.ptr - 3] = (b - a) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = (b - a) >> 8;
+				u->wst.dat[wptr - 3] = (b - a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x3a: /* MUL2 */
+			NEXT;
+		CASE(0x3a) /* MUL2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr - 4] = (b * a) >> 8;
-				u->wst.dat[u->wst.ptr - 3] = (b * a) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr - 4] = (b * a) >> 8;
+				u->wst.dat[wptr - 3] = (b * a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x3b: /* DIV2 */
+			NEXT;
+		CASE(0x3b) /* DIV2 */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
 				if(a == 0) {
 					u->wst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -918,453 +1201,473 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->wst.dat[u->wst.ptr - 4] = (b / a) >> 8;
-				u->wst.dat[u->wst.ptr - 3] = (b / a) & 0xff;
+				u->wst.dat[wptr - 4] = (b / a) >> 8;
+				u->wst.dat[wptr - 3] = (b / a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x3c: /* AND2 */
+			NEXT;
+		CASE(0x3c) /* AND2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr - 4] = d & b;
-				u->wst.dat[u->wst.ptr - 3] = c & a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr - 4] = d & b;
+				u->wst.dat[wptr - 3] = c & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x3d: /* ORA2 */
+			NEXT;
+		CASE(0x3d) /* ORA2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr - 4] = d | b;
-				u->wst.dat[u->wst.ptr - 3] = c | a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr - 4] = d | b;
+				u->wst.dat[wptr - 3] = c | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x3e: /* EOR2 */
+			NEXT;
+		CASE(0x3e) /* EOR2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr - 4] = d ^ b;
-				u->wst.dat[u->wst.ptr - 3] = c ^ a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr - 4] = d ^ b;
+				u->wst.dat[wptr - 3] = c ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 2;
+				wptr -= 2;
 			}
-			break;
-		case 0x3f: /* SFT2 */
+			NEXT;
+		CASE(0x3f) /* SFT2 */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
-				u->wst.dat[u->wst.ptr - 3] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
-				u->wst.dat[u->wst.ptr - 2] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
+				u->wst.dat[wptr - 3] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
+				u->wst.dat[wptr - 2] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
-				u->wst.ptr -= 1;
+				wptr -= 1;
 			}
-			break;
-		case 0x40: /* LITr */
-		case 0xc0: /* LITkr */
+			NEXT;
+		CASE(0x40) /* LITr */
+		CASE(0xc0) /* LITkr */
 			{
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, u->ram.ptr++);
+				u->rst.dat[rptr] = peek8(u->ram.dat, pc++);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x41: /* INCr */
+			NEXT;
+		CASE(0x41) /* INCr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 1] = a + 1;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr - 1] = a + 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x42: /* POPr */
+			NEXT;
+		CASE(0x42) /* POPr */
 			{
-				u->rst.dat[u->rst.ptr - 1];
+				u->rst.dat[rptr - 1];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x43: /* DUPr */
+			NEXT;
+		CASE(0x43) /* DUPr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x44: /* NIPr */
+			NEXT;
+		CASE(0x44) /* NIPr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x45: /* SWPr */
+			NEXT;
+		CASE(0x45) /* SWPr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = a;
-				u->rst.dat[u->rst.ptr - 1] = b;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = a;
+				u->rst.dat[rptr - 1] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x46: /* OVRr */
+			NEXT;
+		CASE(0x46) /* OVRr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x47: /* ROTr */
+			NEXT;
+		CASE(0x47) /* ROTr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3];
-				u->rst.dat[u->rst.ptr - 3] = b;
-				u->rst.dat[u->rst.ptr - 2] = a;
-				u->rst.dat[u->rst.ptr - 1] = c;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3];
+				u->rst.dat[rptr - 3] = b;
+				u->rst.dat[rptr - 2] = a;
+				u->rst.dat[rptr - 1] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x48: /* EQUr */
+			NEXT;
+		CASE(0x48) /* EQUr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b == a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x49: /* NEQr */
+			NEXT;
+		CASE(0x49) /* NEQr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b != a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x4a: /* GTHr */
+			NEXT;
+		CASE(0x4a) /* GTHr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b > a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x4b: /* LTHr */
+			NEXT;
+		CASE(0x4b) /* LTHr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b < a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x4c: /* JMPr */
+			NEXT;
+		CASE(0x4c) /* JMPr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x4d: /* JCNr */
+			NEXT;
+		CASE(0x4d) /* JCNr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				if(u->rst.dat[u->rst.ptr - 2]) u->ram.ptr += (Sint8)a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				if(u->rst.dat[rptr - 2]) {
+					pc += (Sint8)a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x4e: /* JSRr */
+			NEXT;
+		CASE(0x4e) /* JSRr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = u->ram.ptr >> 8;
-				u->wst.dat[u->wst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->wst.dat[wptr] = pc >> 8;
+				u->wst.dat[wptr + 1] = pc & 0xff;
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x4f: /* STHr */
+			NEXT;
+		CASE(0x4f) /* STHr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->wst.dat[wptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x50: /* LDZr */
+			NEXT;
+		CASE(0x50) /* LDZr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 1] = peek8(u->ram.dat, a);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr - 1] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x51: /* STZr */
+			NEXT;
+		CASE(0x51) /* STZr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint8 b = u->rst.dat[u->rst.ptr - 2];
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x52: /* LDRr */
+			NEXT;
+		CASE(0x52) /* LDRr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 1] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr - 1] = peek8(u->ram.dat, pc + (Sint8)a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x53: /* STRr */
+			NEXT;
+		CASE(0x53) /* STRr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint8 b = u->rst.dat[u->rst.ptr - 2];
-				poke8(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				poke8(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x54: /* LDAr */
+			NEXT;
+		CASE(0x54) /* LDAr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				u->rst.dat[u->rst.ptr - 2] = peek8(u->ram.dat, a);
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->rst.dat[rptr - 2] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x55: /* STAr */
+			NEXT;
+		CASE(0x55) /* STAr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				Uint8 b = u->rst.dat[u->rst.ptr - 3];
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				Uint8 b = u->rst.dat[rptr - 3];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
 			}
-			break;
-		case 0x56: /* DEIr */
+			NEXT;
+		CASE(0x56) /* DEIr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 1] = devr8(&u->dev[a >> 4], a);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->rst.dat[rptr - 1] = devr8(&u->dev[a >> 4], a);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x57: /* DEOr */
+			NEXT;
+		CASE(0x57) /* DEOr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				if(!devw8(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw8(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0x58: /* ADDr */
+			NEXT;
+		CASE(0x58) /* ADDr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b + a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b + a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x59: /* SUBr */
+			NEXT;
+		CASE(0x59) /* SUBr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b - a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b - a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x5a: /* MULr */
+			NEXT;
+		CASE(0x5a) /* MULr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b * a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b * a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x5b: /* DIVr */
+			NEXT;
+		CASE(0x5b) /* DIVr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
 				if(a == 0) {
 					u->rst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -1372,478 +1675,501 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->rst.dat[u->rst.ptr - 2] = b / a;
+				u->rst.dat[rptr - 2] = b / a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x5c: /* ANDr */
+			NEXT;
+		CASE(0x5c) /* ANDr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b & a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x5d: /* ORAr */
+			NEXT;
+		CASE(0x5d) /* ORAr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b | a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x5e: /* EORr */
+			NEXT;
+		CASE(0x5e) /* EORr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b ^ a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x5f: /* SFTr */
+			NEXT;
+		CASE(0x5f) /* SFTr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr - 2] = b >> (a & 0x07) << ((a & 0x70) >> 4);
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr - 2] = b >> (a & 0x0f) << ((a & 0xf0) >> 4);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x60: /* LIT2r */
-		case 0xe0: /* LIT2kr */
+			NEXT;
+		CASE(0x60) /* LIT2r */
+		CASE(0xe0) /* LIT2kr */
 			{
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, u->ram.ptr++);
-				u->rst.dat[u->rst.ptr + 1] = peek8(u->ram.dat, u->ram.ptr++);
+				u->rst.dat[rptr] = peek8(u->ram.dat, pc++);
+				u->rst.dat[rptr + 1] = peek8(u->ram.dat, pc++);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0x61: /* INC2r */
+			NEXT;
+		CASE(0x61) /* INC2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				u->rst.dat[u->rst.ptr - 2] = (a + 1) >> 8;
-				u->rst.dat[u->rst.ptr - 1] = (a + 1) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->rst.dat[rptr - 2] = (a + 1) >> 8;
+				u->rst.dat[rptr - 1] = (a + 1) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x62: /* POP2r */
+			NEXT;
+		CASE(0x62) /* POP2r */
 			{
-				(u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
+				(u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x63: /* DUP2r */
+			NEXT;
+		CASE(0x63) /* DUP2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b;
-				u->rst.dat[u->rst.ptr + 1] = a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b;
+				u->rst.dat[rptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0x64: /* NIP2r */
+			NEXT;
+		CASE(0x64) /* NIP2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				(u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = a >> 8;
-				u->rst.dat[u->rst.ptr - 3] = a & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				(u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = a >> 8;
+				u->rst.dat[rptr - 3] = a & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x65: /* SWP2r */
+			NEXT;
+		CASE(0x65) /* SWP2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr - 4] = b;
-				u->rst.dat[u->rst.ptr - 3] = a;
-				u->rst.dat[u->rst.ptr - 2] = d;
-				u->rst.dat[u->rst.ptr - 1] = c;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr - 4] = b;
+				u->rst.dat[rptr - 3] = a;
+				u->rst.dat[rptr - 2] = d;
+				u->rst.dat[rptr - 1] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x66: /* OVR2r */
+			NEXT;
+		CASE(0x66) /* OVR2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr] = d;
-				u->rst.dat[u->rst.ptr + 1] = c;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr] = d;
+				u->rst.dat[rptr + 1] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0x67: /* ROT2r */
+			NEXT;
+		CASE(0x67) /* ROT2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4], e = u->rst.dat[u->rst.ptr - 5], f = u->rst.dat[u->rst.ptr - 6];
-				u->rst.dat[u->rst.ptr - 6] = d;
-				u->rst.dat[u->rst.ptr - 5] = c;
-				u->rst.dat[u->rst.ptr - 4] = b;
-				u->rst.dat[u->rst.ptr - 3] = a;
-				u->rst.dat[u->rst.ptr - 2] = f;
-				u->rst.dat[u->rst.ptr - 1] = e;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4], e = u->rst.dat[rptr - 5], f = u->rst.dat[rptr - 6];
+				u->rst.dat[rptr - 6] = d;
+				u->rst.dat[rptr - 5] = c;
+				u->rst.dat[rptr - 4] = b;
+				u->rst.dat[rptr - 3] = a;
+				u->rst.dat[rptr - 2] = f;
+				u->rst.dat[rptr - 1] = e;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 6, 0)) {
+				if(__builtin_expect(rptr < 6, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x68: /* EQU2r */
+			NEXT;
+		CASE(0x68) /* EQU2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = b == a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
 			}
-			break;
-		case 0x69: /* NEQ2r */
+			NEXT;
+		CASE(0x69) /* NEQ2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = b != a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
 			}
-			break;
-		case 0x6a: /* GTH2r */
+			NEXT;
+		CASE(0x6a) /* GTH2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = b > a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
 			}
-			break;
-		case 0x6b: /* LTH2r */
+			NEXT;
+		CASE(0x6b) /* LTH2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = b < a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
 			}
-			break;
-		case 0x6c: /* JMP2r */
+			NEXT;
+		CASE(0x6c) /* JMP2r */
 			{
-				u->ram.ptr = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x6d: /* JCN2r */
+			NEXT;
+		CASE(0x6d) /* JCN2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				if(u->rst.dat[u->rst.ptr - 3]) u->ram.ptr = a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				if(u->rst.dat[rptr - 3]) {
+					pc = a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x6e: /* JSR2r */
+			NEXT;
+		CASE(0x6e) /* JSR2r */
 			{
-				u->wst.dat[u->wst.ptr] = u->ram.ptr >> 8;
-				u->wst.dat[u->wst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->wst.dat[wptr] = pc >> 8;
+				u->wst.dat[wptr + 1] = pc & 0xff;
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x6f: /* STH2r */
+			NEXT;
+		CASE(0x6f) /* STH2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b;
-				u->wst.dat[u->wst.ptr + 1] = a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->wst.dat[wptr] = b;
+				u->wst.dat[wptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0x70: /* LDZ2r */
+			NEXT;
+		CASE(0x70) /* LDZ2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 1] = peek8(u->ram.dat, a);
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, a + 1);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr - 1] = peek8(u->ram.dat, a);
+				u->rst.dat[rptr] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x71: /* STZ2r */
+			NEXT;
+		CASE(0x71) /* STZ2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
 			}
-			break;
-		case 0x72: /* LDR2r */
+			NEXT;
+		CASE(0x72) /* LDR2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 1] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a + 1);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr - 1] = peek8(u->ram.dat, pc + (Sint8)a);
+				u->rst.dat[rptr] = peek8(u->ram.dat, pc + (Sint8)a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x73: /* STR2r */
+			NEXT;
+		CASE(0x73) /* STR2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
-				poke16(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
+				poke16(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
 			}
-			break;
-		case 0x74: /* LDA2r */
+			NEXT;
+		CASE(0x74) /* LDA2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				u->rst.dat[u->rst.ptr - 2] = peek8(u->ram.dat, a);
-				u->rst.dat[u->rst.ptr - 1] = peek8(u->ram.dat, a + 1);
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->rst.dat[rptr - 2] = peek8(u->ram.dat, a);
+				u->rst.dat[rptr - 1] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x75: /* STA2r */
+			NEXT;
+		CASE(0x75) /* STA2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				Uint16 b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 4;
+				rptr -= 4;
 			}
-			break;
-		case 0x76: /* DEI2r */
+			NEXT;
+		CASE(0x76) /* DEI2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 1] = devr8(&u->dev[a >> 4], a);
-				u->rst.dat[u->rst.ptr] = devr8(&u->dev[a >> 4], a + 1);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->rst.dat[rptr - 1] = devr8(&u->dev[a >> 4], a);
+				u->rst.dat[rptr] = devr8(&u->dev[a >> 4], a + 1);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x77: /* DEO2r */
+			NEXT;
+		CASE(0x77) /* DEO2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
-				if(!devw16(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 3;
+				rptr -= 3;
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw16(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0x78: /* ADD2r */
+			NEXT;
+		CASE(0x78) /* ADD2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = (b + a) >> 8;
-				u->rst.dat[u->rst.ptr - 3] = (b + a) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = (b + a) >> 8;
+				u->rst.dat[rptr - 3] = (b + a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x79: /* SUB2r */
+			NEXT;
+		CASE(0x79) /* SUB2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = (b - a) >> 8;
-				u->rst.dat[u->rst.ptr - 3] = (b - a) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = (b - a) >> 8;
+				u->rst.dat[rptr - 3] = (b - a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x7a: /* MUL2r */
+			NEXT;
+		CASE(0x7a) /* MUL2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr - 4] = (b * a) >> 8;
-				u->rst.dat[u->rst.ptr - 3] = (b * a) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr - 4] = (b * a) >> 8;
+				u->rst.dat[rptr - 3] = (b * a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x7b: /* DIV2r */
+			NEXT;
+		CASE(0x7b) /* DIV2r */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
 				if(a == 0) {
 					u->rst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -1851,496 +2177,516 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->rst.dat[u->rst.ptr - 4] = (b / a) >> 8;
-				u->rst.dat[u->rst.ptr - 3] = (b / a) & 0xff;
+				u->rst.dat[rptr - 4] = (b / a) >> 8;
+				u->rst.dat[rptr - 3] = (b / a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x7c: /* AND2r */
+			NEXT;
+		CASE(0x7c) /* AND2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr - 4] = d & b;
-				u->rst.dat[u->rst.ptr - 3] = c & a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr - 4] = d & b;
+				u->rst.dat[rptr - 3] = c & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x7d: /* ORA2r */
+			NEXT;
+		CASE(0x7d) /* ORA2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr - 4] = d | b;
-				u->rst.dat[u->rst.ptr - 3] = c | a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr - 4] = d | b;
+				u->rst.dat[rptr - 3] = c | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x7e: /* EOR2r */
+			NEXT;
+		CASE(0x7e) /* EOR2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr - 4] = d ^ b;
-				u->rst.dat[u->rst.ptr - 3] = c ^ a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr - 4] = d ^ b;
+				u->rst.dat[rptr - 3] = c ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 2;
+				rptr -= 2;
 			}
-			break;
-		case 0x7f: /* SFT2r */
+			NEXT;
+		CASE(0x7f) /* SFT2r */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
-				u->rst.dat[u->rst.ptr - 3] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
-				u->rst.dat[u->rst.ptr - 2] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
+				u->rst.dat[rptr - 3] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
+				u->rst.dat[rptr - 2] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
-				u->rst.ptr -= 1;
+				rptr -= 1;
 			}
-			break;
-		case 0x81: /* INCk */
+			NEXT;
+		CASE(0x81) /* INCk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = a + 1;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr] = a + 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x82: /* POPk */
+			NEXT;
+		CASE(0x82) /* POPk */
 			{
-				u->wst.dat[u->wst.ptr - 1];
+				u->wst.dat[wptr - 1];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x83: /* DUPk */
+			NEXT;
+		CASE(0x83) /* DUPk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = a;
-				u->wst.dat[u->wst.ptr + 1] = a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr] = a;
+				u->wst.dat[wptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0x84: /* NIPk */
+			NEXT;
+		CASE(0x84) /* NIPk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x85: /* SWPk */
+			NEXT;
+		CASE(0x85) /* SWPk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = a;
-				u->wst.dat[u->wst.ptr + 1] = b;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = a;
+				u->wst.dat[wptr + 1] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0x86: /* OVRk */
+			NEXT;
+		CASE(0x86) /* OVRk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b;
-				u->wst.dat[u->wst.ptr + 1] = a;
-				u->wst.dat[u->wst.ptr + 2] = b;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b;
+				u->wst.dat[wptr + 1] = a;
+				u->wst.dat[wptr + 2] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 252, 0)) {
+				if(__builtin_expect(wptr > 252, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 3;
+				wptr += 3;
 			}
-			break;
-		case 0x87: /* ROTk */
+			NEXT;
+		CASE(0x87) /* ROTk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3];
-				u->wst.dat[u->wst.ptr] = b;
-				u->wst.dat[u->wst.ptr + 1] = a;
-				u->wst.dat[u->wst.ptr + 2] = c;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3];
+				u->wst.dat[wptr] = b;
+				u->wst.dat[wptr + 1] = a;
+				u->wst.dat[wptr + 2] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 252, 0)) {
+				if(__builtin_expect(wptr > 252, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 3;
+				wptr += 3;
 			}
-			break;
-		case 0x88: /* EQUk */
+			NEXT;
+		CASE(0x88) /* EQUk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b == a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x89: /* NEQk */
+			NEXT;
+		CASE(0x89) /* NEQk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b != a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x8a: /* GTHk */
+			NEXT;
+		CASE(0x8a) /* GTHk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b > a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x8b: /* LTHk */
+			NEXT;
+		CASE(0x8b) /* LTHk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b < a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x8c: /* JMPk */
+			NEXT;
+		CASE(0x8c) /* JMPk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x8d: /* JCNk */
+			NEXT;
+		CASE(0x8d) /* JCNk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				if(u->wst.dat[u->wst.ptr - 2]) u->ram.ptr += (Sint8)a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				if(u->wst.dat[wptr - 2]) {
+					pc += (Sint8)a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x8e: /* JSRk */
+			NEXT;
+		CASE(0x8e) /* JSRk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = u->ram.ptr >> 8;
-				u->rst.dat[u->rst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->rst.dat[rptr] = pc >> 8;
+				u->rst.dat[rptr + 1] = pc & 0xff;
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0x8f: /* STHk */
+			NEXT;
+		CASE(0x8f) /* STHk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = a;
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->rst.dat[rptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0x90: /* LDZk */
+			NEXT;
+		CASE(0x90) /* LDZk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, a);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x91: /* STZk */
+			NEXT;
+		CASE(0x91) /* STZk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint8 b = u->wst.dat[u->wst.ptr - 2];
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x92: /* LDRk */
+			NEXT;
+		CASE(0x92) /* LDRk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr] = peek8(u->ram.dat, pc + (Sint8)a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x93: /* STRk */
+			NEXT;
+		CASE(0x93) /* STRk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint8 b = u->wst.dat[u->wst.ptr - 2];
-				poke8(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				poke8(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x94: /* LDAk */
+			NEXT;
+		CASE(0x94) /* LDAk */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, a);
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x95: /* STAk */
+			NEXT;
+		CASE(0x95) /* STAk */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				Uint8 b = u->wst.dat[u->wst.ptr - 3];
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				Uint8 b = u->wst.dat[wptr - 3];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0x96: /* DEIk */
+			NEXT;
+		CASE(0x96) /* DEIk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = devr8(&u->dev[a >> 4], a);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->wst.dat[wptr] = devr8(&u->dev[a >> 4], a);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x97: /* DEOk */
+			NEXT;
+		CASE(0x97) /* DEOk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				if(!devw8(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw8(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0x98: /* ADDk */
+			NEXT;
+		CASE(0x98) /* ADDk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b + a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b + a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x99: /* SUBk */
+			NEXT;
+		CASE(0x99) /* SUBk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b - a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b - a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x9a: /* MULk */
+			NEXT;
+		CASE(0x9a) /* MULk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b * a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b * a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x9b: /* DIVk */
+			NEXT;
+		CASE(0x9b) /* DIVk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
 				if(a == 0) {
 					u->wst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -2348,529 +2694,552 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->wst.dat[u->wst.ptr] = b / a;
+				u->wst.dat[wptr] = b / a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x9c: /* ANDk */
+			NEXT;
+		CASE(0x9c) /* ANDk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b & a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x9d: /* ORAk */
+			NEXT;
+		CASE(0x9d) /* ORAk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b | a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x9e: /* EORk */
+			NEXT;
+		CASE(0x9e) /* EORk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b ^ a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0x9f: /* SFTk */
+			NEXT;
+		CASE(0x9f) /* SFTk */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b >> (a & 0x07) << ((a & 0x70) >> 4);
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b >> (a & 0x0f) << ((a & 0xf0) >> 4);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0xa1: /* INC2k */
+			NEXT;
+		CASE(0xa1) /* INC2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				u->wst.dat[u->wst.ptr] = (a + 1) >> 8;
-				u->wst.dat[u->wst.ptr + 1] = (a + 1) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr] = (a + 1) >> 8;
+				u->wst.dat[wptr + 1] = (a + 1) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xa2: /* POP2k */
+			NEXT;
+		CASE(0xa2) /* POP2k */
 			{
-				(u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
+				(u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xa3: /* DUP2k */
+			NEXT;
+		CASE(0xa3) /* DUP2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b;
-				u->wst.dat[u->wst.ptr + 1] = a;
-				u->wst.dat[u->wst.ptr + 2] = b;
-				u->wst.dat[u->wst.ptr + 3] = a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->wst.dat[wptr] = b;
+				u->wst.dat[wptr + 1] = a;
+				u->wst.dat[wptr + 2] = b;
+				u->wst.dat[wptr + 3] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 251, 0)) {
+				if(__builtin_expect(wptr > 251, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 4;
+				wptr += 4;
 			}
-			break;
-		case 0xa4: /* NIP2k */
+			NEXT;
+		CASE(0xa4) /* NIP2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				(u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = a >> 8;
-				u->wst.dat[u->wst.ptr + 1] = a & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				(u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = a >> 8;
+				u->wst.dat[wptr + 1] = a & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xa5: /* SWP2k */
+			NEXT;
+		CASE(0xa5) /* SWP2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr] = b;
-				u->wst.dat[u->wst.ptr + 1] = a;
-				u->wst.dat[u->wst.ptr + 2] = d;
-				u->wst.dat[u->wst.ptr + 3] = c;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr] = b;
+				u->wst.dat[wptr + 1] = a;
+				u->wst.dat[wptr + 2] = d;
+				u->wst.dat[wptr + 3] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 251, 0)) {
+				if(__builtin_expect(wptr > 251, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 4;
+				wptr += 4;
 			}
-			break;
-		case 0xa6: /* OVR2k */
+			NEXT;
+		CASE(0xa6) /* OVR2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr] = d;
-				u->wst.dat[u->wst.ptr + 1] = c;
-				u->wst.dat[u->wst.ptr + 2] = b;
-				u->wst.dat[u->wst.ptr + 3] = a;
-				u->wst.dat[u->wst.ptr + 4] = d;
-				u->wst.dat[u->wst.ptr + 5] = c;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr] = d;
+				u->wst.dat[wptr + 1] = c;
+				u->wst.dat[wptr + 2] = b;
+				u->wst.dat[wptr + 3] = a;
+				u->wst.dat[wptr + 4] = d;
+				u->wst.dat[wptr + 5] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 249, 0)) {
+				if(__builtin_expect(wptr > 249, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 6;
+				wptr += 6;
 			}
-			break;
-		case 0xa7: /* ROT2k */
+			NEXT;
+		CASE(0xa7) /* ROT2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4], e = u->wst.dat[u->wst.ptr - 5], f = u->wst.dat[u->wst.ptr - 6];
-				u->wst.dat[u->wst.ptr] = d;
-				u->wst.dat[u->wst.ptr + 1] = c;
-				u->wst.dat[u->wst.ptr + 2] = b;
-				u->wst.dat[u->wst.ptr + 3] = a;
-				u->wst.dat[u->wst.ptr + 4] = f;
-				u->wst.dat[u->wst.ptr + 5] = e;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4], e = u->wst.dat[wptr - 5], f = u->wst.dat[wptr - 6];
+				u->wst.dat[wptr] = d;
+				u->wst.dat[wptr + 1] = c;
+				u->wst.dat[wptr + 2] = b;
+				u->wst.dat[wptr + 3] = a;
+				u->wst.dat[wptr + 4] = f;
+				u->wst.dat[wptr + 5] = e;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 6, 0)) {
+				if(__builtin_expect(wptr < 6, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 249, 0)) {
+				if(__builtin_expect(wptr > 249, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 6;
+				wptr += 6;
 			}
-			break;
-		case 0xa8: /* EQU2k */
+			NEXT;
+		CASE(0xa8) /* EQU2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = b == a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0xa9: /* NEQ2k */
+			NEXT;
+		CASE(0xa9) /* NEQ2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = b != a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0xaa: /* GTH2k */
+			NEXT;
+		CASE(0xaa) /* GTH2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = b > a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0xab: /* LTH2k */
+			NEXT;
+		CASE(0xab) /* LTH2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = b < a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0xac: /* JMP2k */
+			NEXT;
+		CASE(0xac) /* JMP2k */
 			{
-				u->ram.ptr = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xad: /* JCN2k */
+			NEXT;
+		CASE(0xad) /* JCN2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				if(u->wst.dat[u->wst.ptr - 3]) u->ram.ptr = a;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				if(u->wst.dat[wptr - 3]) {
+					pc = a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xae: /* JSR2k */
+			NEXT;
+		CASE(0xae) /* JSR2k */
 			{
-				u->rst.dat[u->rst.ptr] = u->ram.ptr >> 8;
-				u->rst.dat[u->rst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->rst.dat[rptr] = pc >> 8;
+				u->rst.dat[rptr + 1] = pc & 0xff;
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xaf: /* STH2k */
+			NEXT;
+		CASE(0xaf) /* STH2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b;
-				u->rst.dat[u->rst.ptr + 1] = a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2];
+				u->rst.dat[rptr] = b;
+				u->rst.dat[rptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xb0: /* LDZ2k */
+			NEXT;
+		CASE(0xb0) /* LDZ2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, a);
-				u->wst.dat[u->wst.ptr + 1] = peek8(u->ram.dat, a + 1);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr] = peek8(u->ram.dat, a);
+				u->wst.dat[wptr + 1] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xb1: /* STZ2k */
+			NEXT;
+		CASE(0xb1) /* STZ2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xb2: /* LDR2k */
+			NEXT;
+		CASE(0xb2) /* LDR2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
-				u->wst.dat[u->wst.ptr + 1] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a + 1);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->wst.dat[wptr] = peek8(u->ram.dat, pc + (Sint8)a);
+				u->wst.dat[wptr + 1] = peek8(u->ram.dat, pc + (Sint8)a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xb3: /* STR2k */
+			NEXT;
+		CASE(0xb3) /* STR2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
-				poke16(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
+				poke16(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xb4: /* LDA2k */
+			NEXT;
+		CASE(0xb4) /* LDA2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				u->wst.dat[u->wst.ptr] = peek8(u->ram.dat, a);
-				u->wst.dat[u->wst.ptr + 1] = peek8(u->ram.dat, a + 1);
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8));
+				u->wst.dat[wptr] = peek8(u->ram.dat, a);
+				u->wst.dat[wptr + 1] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 2, 0)) {
+				if(__builtin_expect(wptr < 2, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xb5: /* STA2k */
+			NEXT;
+		CASE(0xb5) /* STA2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8));
-				Uint16 b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xb6: /* DEI2k */
+			NEXT;
+		CASE(0xb6) /* DEI2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = devr8(&u->dev[a >> 4], a);
-				u->wst.dat[u->wst.ptr + 1] = devr8(&u->dev[a >> 4], a + 1);
+				Uint8 a = u->wst.dat[wptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->wst.dat[wptr] = devr8(&u->dev[a >> 4], a);
+				u->wst.dat[wptr + 1] = devr8(&u->dev[a >> 4], a + 1);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 1, 0)) {
+				if(__builtin_expect(wptr < 1, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xb7: /* DEO2k */
+			NEXT;
+		CASE(0xb7) /* DEO2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
-				if(!devw16(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
 #endif
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw16(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0xb8: /* ADD2k */
+			NEXT;
+		CASE(0xb8) /* ADD2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = (b + a) >> 8;
-				u->wst.dat[u->wst.ptr + 1] = (b + a) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = (b + a) >> 8;
+				u->wst.dat[wptr + 1] = (b + a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xb9: /* SUB2k */
+			NEXT;
+		CASE(0xb9) /* SUB2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = (b - a) >> 8;
-				u->wst.dat[u->wst.ptr + 1] = (b - a) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = (b - a) >> 8;
+				u->wst.dat[wptr + 1] = (b - a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xba: /* MUL2k */
+			NEXT;
+		CASE(0xba) /* MUL2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
-				u->wst.dat[u->wst.ptr] = (b * a) >> 8;
-				u->wst.dat[u->wst.ptr + 1] = (b * a) & 0xff;
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
+				u->wst.dat[wptr] = (b * a) >> 8;
+				u->wst.dat[wptr + 1] = (b * a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xbb: /* DIV2k */
+			NEXT;
+		CASE(0xbb) /* DIV2k */
 			{
-				Uint16 a = (u->wst.dat[u->wst.ptr - 1] | (u->wst.dat[u->wst.ptr - 2] << 8)), b = (u->wst.dat[u->wst.ptr - 3] | (u->wst.dat[u->wst.ptr - 4] << 8));
+				Uint16 a = (u->wst.dat[wptr - 1] | (u->wst.dat[wptr - 2] << 8)), b = (u->wst.dat[wptr - 3] | (u->wst.dat[wptr - 4] << 8));
 				if(a == 0) {
 					u->wst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -2878,516 +3247,536 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->wst.dat[u->wst.ptr] = (b / a) >> 8;
-				u->wst.dat[u->wst.ptr + 1] = (b / a) & 0xff;
+				u->wst.dat[wptr] = (b / a) >> 8;
+				u->wst.dat[wptr + 1] = (b / a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xbc: /* AND2k */
+			NEXT;
+		CASE(0xbc) /* AND2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr] = d & b;
-				u->wst.dat[u->wst.ptr + 1] = c & a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr] = d & b;
+				u->wst.dat[wptr + 1] = c & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xbd: /* ORA2k */
+			NEXT;
+		CASE(0xbd) /* ORA2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr] = d | b;
-				u->wst.dat[u->wst.ptr + 1] = c | a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr] = d | b;
+				u->wst.dat[wptr + 1] = c | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xbe: /* EOR2k */
+			NEXT;
+		CASE(0xbe) /* EOR2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1], b = u->wst.dat[u->wst.ptr - 2], c = u->wst.dat[u->wst.ptr - 3], d = u->wst.dat[u->wst.ptr - 4];
-				u->wst.dat[u->wst.ptr] = d ^ b;
-				u->wst.dat[u->wst.ptr + 1] = c ^ a;
+				Uint8 a = u->wst.dat[wptr - 1], b = u->wst.dat[wptr - 2], c = u->wst.dat[wptr - 3], d = u->wst.dat[wptr - 4];
+				u->wst.dat[wptr] = d ^ b;
+				u->wst.dat[wptr + 1] = c ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 4, 0)) {
+				if(__builtin_expect(wptr < 4, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xbf: /* SFT2k */
+			NEXT;
+		CASE(0xbf) /* SFT2k */
 			{
-				Uint8 a = u->wst.dat[u->wst.ptr - 1];
-				Uint16 b = (u->wst.dat[u->wst.ptr - 2] | (u->wst.dat[u->wst.ptr - 3] << 8));
-				u->wst.dat[u->wst.ptr] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
-				u->wst.dat[u->wst.ptr + 1] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
+				Uint8 a = u->wst.dat[wptr - 1];
+				Uint16 b = (u->wst.dat[wptr - 2] | (u->wst.dat[wptr - 3] << 8));
+				u->wst.dat[wptr] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
+				u->wst.dat[wptr + 1] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->wst.ptr < 3, 0)) {
+				if(__builtin_expect(wptr < 3, 0)) {
 					u->wst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xc1: /* INCkr */
+			NEXT;
+		CASE(0xc1) /* INCkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = a + 1;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr] = a + 1;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xc2: /* POPkr */
+			NEXT;
+		CASE(0xc2) /* POPkr */
 			{
-				u->rst.dat[u->rst.ptr - 1];
+				u->rst.dat[rptr - 1];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xc3: /* DUPkr */
+			NEXT;
+		CASE(0xc3) /* DUPkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = a;
-				u->rst.dat[u->rst.ptr + 1] = a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr] = a;
+				u->rst.dat[rptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xc4: /* NIPkr */
+			NEXT;
+		CASE(0xc4) /* NIPkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xc5: /* SWPkr */
+			NEXT;
+		CASE(0xc5) /* SWPkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = a;
-				u->rst.dat[u->rst.ptr + 1] = b;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = a;
+				u->rst.dat[rptr + 1] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xc6: /* OVRkr */
+			NEXT;
+		CASE(0xc6) /* OVRkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b;
-				u->rst.dat[u->rst.ptr + 1] = a;
-				u->rst.dat[u->rst.ptr + 2] = b;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b;
+				u->rst.dat[rptr + 1] = a;
+				u->rst.dat[rptr + 2] = b;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 252, 0)) {
+				if(__builtin_expect(rptr > 252, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 3;
+				rptr += 3;
 			}
-			break;
-		case 0xc7: /* ROTkr */
+			NEXT;
+		CASE(0xc7) /* ROTkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3];
-				u->rst.dat[u->rst.ptr] = b;
-				u->rst.dat[u->rst.ptr + 1] = a;
-				u->rst.dat[u->rst.ptr + 2] = c;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3];
+				u->rst.dat[rptr] = b;
+				u->rst.dat[rptr + 1] = a;
+				u->rst.dat[rptr + 2] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 252, 0)) {
+				if(__builtin_expect(rptr > 252, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 3;
+				rptr += 3;
 			}
-			break;
-		case 0xc8: /* EQUkr */
+			NEXT;
+		CASE(0xc8) /* EQUkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b == a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xc9: /* NEQkr */
+			NEXT;
+		CASE(0xc9) /* NEQkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b != a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xca: /* GTHkr */
+			NEXT;
+		CASE(0xca) /* GTHkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b > a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xcb: /* LTHkr */
+			NEXT;
+		CASE(0xcb) /* LTHkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b < a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xcc: /* JMPkr */
+			NEXT;
+		CASE(0xcc) /* JMPkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xcd: /* JCNkr */
+			NEXT;
+		CASE(0xcd) /* JCNkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				if(u->rst.dat[u->rst.ptr - 2]) u->ram.ptr += (Sint8)a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				if(u->rst.dat[rptr - 2]) {
+					pc += (Sint8)a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xce: /* JSRkr */
+			NEXT;
+		CASE(0xce) /* JSRkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = u->ram.ptr >> 8;
-				u->wst.dat[u->wst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr += (Sint8)a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->wst.dat[wptr] = pc >> 8;
+				u->wst.dat[wptr + 1] = pc & 0xff;
+				pc += (Sint8)a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xcf: /* STHkr */
+			NEXT;
+		CASE(0xcf) /* STHkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->wst.dat[u->wst.ptr] = a;
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->wst.dat[wptr] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 254, 0)) {
+				if(__builtin_expect(wptr > 254, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 1;
+				wptr += 1;
 			}
-			break;
-		case 0xd0: /* LDZkr */
+			NEXT;
+		CASE(0xd0) /* LDZkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, a);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xd1: /* STZkr */
+			NEXT;
+		CASE(0xd1) /* STZkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint8 b = u->rst.dat[u->rst.ptr - 2];
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xd2: /* LDRkr */
+			NEXT;
+		CASE(0xd2) /* LDRkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr] = peek8(u->ram.dat, pc + (Sint8)a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xd3: /* STRkr */
+			NEXT;
+		CASE(0xd3) /* STRkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint8 b = u->rst.dat[u->rst.ptr - 2];
-				poke8(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				poke8(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xd4: /* LDAkr */
+			NEXT;
+		CASE(0xd4) /* LDAkr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, a);
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->rst.dat[rptr] = peek8(u->ram.dat, a);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xd5: /* STAkr */
+			NEXT;
+		CASE(0xd5) /* STAkr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				Uint8 b = u->rst.dat[u->rst.ptr - 3];
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				Uint8 b = u->rst.dat[rptr - 3];
 				poke8(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xd6: /* DEIkr */
+			NEXT;
+		CASE(0xd6) /* DEIkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = devr8(&u->dev[a >> 4], a);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->rst.dat[rptr] = devr8(&u->dev[a >> 4], a);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xd7: /* DEOkr */
+			NEXT;
+		CASE(0xd7) /* DEOkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				if(!devw8(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw8(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0xd8: /* ADDkr */
+			NEXT;
+		CASE(0xd8) /* ADDkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b + a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b + a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xd9: /* SUBkr */
+			NEXT;
+		CASE(0xd9) /* SUBkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b - a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b - a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xda: /* MULkr */
+			NEXT;
+		CASE(0xda) /* MULkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b * a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b * a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xdb: /* DIVkr */
+			NEXT;
+		CASE(0xdb) /* DIVkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
 				if(a == 0) {
 					u->rst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -3395,529 +3784,552 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->rst.dat[u->rst.ptr] = b / a;
+				u->rst.dat[rptr] = b / a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xdc: /* ANDkr */
+			NEXT;
+		CASE(0xdc) /* ANDkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b & a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xdd: /* ORAkr */
+			NEXT;
+		CASE(0xdd) /* ORAkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b | a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xde: /* EORkr */
+			NEXT;
+		CASE(0xde) /* EORkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b ^ a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xdf: /* SFTkr */
+			NEXT;
+		CASE(0xdf) /* SFTkr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b >> (a & 0x07) << ((a & 0x70) >> 4);
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b >> (a & 0x0f) << ((a & 0xf0) >> 4);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xe1: /* INC2kr */
+			NEXT;
+		CASE(0xe1) /* INC2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				u->rst.dat[u->rst.ptr] = (a + 1) >> 8;
-				u->rst.dat[u->rst.ptr + 1] = (a + 1) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->rst.dat[rptr] = (a + 1) >> 8;
+				u->rst.dat[rptr + 1] = (a + 1) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xe2: /* POP2kr */
+			NEXT;
+		CASE(0xe2) /* POP2kr */
 			{
-				(u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
+				(u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xe3: /* DUP2kr */
+			NEXT;
+		CASE(0xe3) /* DUP2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->rst.dat[u->rst.ptr] = b;
-				u->rst.dat[u->rst.ptr + 1] = a;
-				u->rst.dat[u->rst.ptr + 2] = b;
-				u->rst.dat[u->rst.ptr + 3] = a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->rst.dat[rptr] = b;
+				u->rst.dat[rptr + 1] = a;
+				u->rst.dat[rptr + 2] = b;
+				u->rst.dat[rptr + 3] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 251, 0)) {
+				if(__builtin_expect(rptr > 251, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 4;
+				rptr += 4;
 			}
-			break;
-		case 0xe4: /* NIP2kr */
+			NEXT;
+		CASE(0xe4) /* NIP2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				(u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = a >> 8;
-				u->rst.dat[u->rst.ptr + 1] = a & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				(u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = a >> 8;
+				u->rst.dat[rptr + 1] = a & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xe5: /* SWP2kr */
+			NEXT;
+		CASE(0xe5) /* SWP2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr] = b;
-				u->rst.dat[u->rst.ptr + 1] = a;
-				u->rst.dat[u->rst.ptr + 2] = d;
-				u->rst.dat[u->rst.ptr + 3] = c;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr] = b;
+				u->rst.dat[rptr + 1] = a;
+				u->rst.dat[rptr + 2] = d;
+				u->rst.dat[rptr + 3] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 251, 0)) {
+				if(__builtin_expect(rptr > 251, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 4;
+				rptr += 4;
 			}
-			break;
-		case 0xe6: /* OVR2kr */
+			NEXT;
+		CASE(0xe6) /* OVR2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr] = d;
-				u->rst.dat[u->rst.ptr + 1] = c;
-				u->rst.dat[u->rst.ptr + 2] = b;
-				u->rst.dat[u->rst.ptr + 3] = a;
-				u->rst.dat[u->rst.ptr + 4] = d;
-				u->rst.dat[u->rst.ptr + 5] = c;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr] = d;
+				u->rst.dat[rptr + 1] = c;
+				u->rst.dat[rptr + 2] = b;
+				u->rst.dat[rptr + 3] = a;
+				u->rst.dat[rptr + 4] = d;
+				u->rst.dat[rptr + 5] = c;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 249, 0)) {
+				if(__builtin_expect(rptr > 249, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 6;
+				rptr += 6;
 			}
-			break;
-		case 0xe7: /* ROT2kr */
+			NEXT;
+		CASE(0xe7) /* ROT2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4], e = u->rst.dat[u->rst.ptr - 5], f = u->rst.dat[u->rst.ptr - 6];
-				u->rst.dat[u->rst.ptr] = d;
-				u->rst.dat[u->rst.ptr + 1] = c;
-				u->rst.dat[u->rst.ptr + 2] = b;
-				u->rst.dat[u->rst.ptr + 3] = a;
-				u->rst.dat[u->rst.ptr + 4] = f;
-				u->rst.dat[u->rst.ptr + 5] = e;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4], e = u->rst.dat[rptr - 5], f = u->rst.dat[rptr - 6];
+				u->rst.dat[rptr] = d;
+				u->rst.dat[rptr + 1] = c;
+				u->rst.dat[rptr + 2] = b;
+				u->rst.dat[rptr + 3] = a;
+				u->rst.dat[rptr + 4] = f;
+				u->rst.dat[rptr + 5] = e;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 6, 0)) {
+				if(__builtin_expect(rptr < 6, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 249, 0)) {
+				if(__builtin_expect(rptr > 249, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 6;
+				rptr += 6;
 			}
-			break;
-		case 0xe8: /* EQU2kr */
+			NEXT;
+		CASE(0xe8) /* EQU2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = b == a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = b == a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xe9: /* NEQ2kr */
+			NEXT;
+		CASE(0xe9) /* NEQ2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = b != a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = b != a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xea: /* GTH2kr */
+			NEXT;
+		CASE(0xea) /* GTH2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = b > a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = b > a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xeb: /* LTH2kr */
+			NEXT;
+		CASE(0xeb) /* LTH2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = b < a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = b < a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 254, 0)) {
+				if(__builtin_expect(rptr > 254, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 1;
+				rptr += 1;
 			}
-			break;
-		case 0xec: /* JMP2kr */
+			NEXT;
+		CASE(0xec) /* JMP2kr */
 			{
-				u->ram.ptr = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xed: /* JCN2kr */
+			NEXT;
+		CASE(0xed) /* JCN2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				if(u->rst.dat[u->rst.ptr - 3]) u->ram.ptr = a;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				if(u->rst.dat[rptr - 3]) {
+					pc = a;
+					steps--;
+				}
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xee: /* JSR2kr */
+			NEXT;
+		CASE(0xee) /* JSR2kr */
 			{
-				u->wst.dat[u->wst.ptr] = u->ram.ptr >> 8;
-				u->wst.dat[u->wst.ptr + 1] = u->ram.ptr & 0xff;
-				u->ram.ptr = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->wst.dat[wptr] = pc >> 8;
+				u->wst.dat[wptr + 1] = pc & 0xff;
+				pc = a;
+				steps--;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
+				if(__builtin_expect(!steps, 0))
+					goto suspend;
 			}
-			break;
-		case 0xef: /* STH2kr */
+			NEXT;
+		CASE(0xef) /* STH2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2];
-				u->wst.dat[u->wst.ptr] = b;
-				u->wst.dat[u->wst.ptr + 1] = a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2];
+				u->wst.dat[wptr] = b;
+				u->wst.dat[wptr + 1] = a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->wst.ptr > 253, 0)) {
+				if(__builtin_expect(wptr > 253, 0)) {
 					u->wst.error = 2;
 					goto error;
 				}
 #endif
-				u->wst.ptr += 2;
+				wptr += 2;
 			}
-			break;
-		case 0xf0: /* LDZ2kr */
+			NEXT;
+		CASE(0xf0) /* LDZ2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, a);
-				u->rst.dat[u->rst.ptr + 1] = peek8(u->ram.dat, a + 1);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr] = peek8(u->ram.dat, a);
+				u->rst.dat[rptr + 1] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xf1: /* STZ2kr */
+			NEXT;
+		CASE(0xf1) /* STZ2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xf2: /* LDR2kr */
+			NEXT;
+		CASE(0xf2) /* LDR2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a);
-				u->rst.dat[u->rst.ptr + 1] = peek8(u->ram.dat, u->ram.ptr + (Sint8)a + 1);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->rst.dat[rptr] = peek8(u->ram.dat, pc + (Sint8)a);
+				u->rst.dat[rptr + 1] = peek8(u->ram.dat, pc + (Sint8)a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xf3: /* STR2kr */
+			NEXT;
+		CASE(0xf3) /* STR2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
-				poke16(u->ram.dat, u->ram.ptr + (Sint8)a, b);
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
+				poke16(u->ram.dat, pc + (Sint8)a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xf4: /* LDA2kr */
+			NEXT;
+		CASE(0xf4) /* LDA2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				u->rst.dat[u->rst.ptr] = peek8(u->ram.dat, a);
-				u->rst.dat[u->rst.ptr + 1] = peek8(u->ram.dat, a + 1);
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8));
+				u->rst.dat[rptr] = peek8(u->ram.dat, a);
+				u->rst.dat[rptr + 1] = peek8(u->ram.dat, a + 1);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 2, 0)) {
+				if(__builtin_expect(rptr < 2, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xf5: /* STA2kr */
+			NEXT;
+		CASE(0xf5) /* STA2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8));
-				Uint16 b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
 				poke16(u->ram.dat, a, b);
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
 			}
-			break;
-		case 0xf6: /* DEI2kr */
+			NEXT;
+		CASE(0xf6) /* DEI2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				u->rst.dat[u->rst.ptr] = devr8(&u->dev[a >> 4], a);
-				u->rst.dat[u->rst.ptr + 1] = devr8(&u->dev[a >> 4], a + 1);
+				Uint8 a = u->rst.dat[rptr - 1];
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				u->rst.dat[rptr] = devr8(&u->dev[a >> 4], a);
+				u->rst.dat[rptr + 1] = devr8(&u->dev[a >> 4], a + 1);
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 1, 0)) {
+				if(__builtin_expect(rptr < 1, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xf7: /* DEO2kr */
+			NEXT;
+		CASE(0xf7) /* DEO2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
-				if(!devw16(&u->dev[a >> 4], a, b))
-					return 1;
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
 #endif
+				u->ram.ptr = pc;
+				u->wst.ptr = wptr;
+				u->rst.ptr = rptr;
+				if (!devw16(&u->dev[a >> 4], a, b)) return 1;
+				pc = u->ram.ptr;
+				wptr = u->wst.ptr;
+				rptr = u->rst.ptr;
 			}
-			break;
-		case 0xf8: /* ADD2kr */
+			NEXT;
+		CASE(0xf8) /* ADD2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = (b + a) >> 8;
-				u->rst.dat[u->rst.ptr + 1] = (b + a) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = (b + a) >> 8;
+				u->rst.dat[rptr + 1] = (b + a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xf9: /* SUB2kr */
+			NEXT;
+		CASE(0xf9) /* SUB2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = (b - a) >> 8;
-				u->rst.dat[u->rst.ptr + 1] = (b - a) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = (b - a) >> 8;
+				u->rst.dat[rptr + 1] = (b - a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xfa: /* MUL2kr */
+			NEXT;
+		CASE(0xfa) /* MUL2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
-				u->rst.dat[u->rst.ptr] = (b * a) >> 8;
-				u->rst.dat[u->rst.ptr + 1] = (b * a) & 0xff;
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
+				u->rst.dat[rptr] = (b * a) >> 8;
+				u->rst.dat[rptr + 1] = (b * a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xfb: /* DIV2kr */
+			NEXT;
+		CASE(0xfb) /* DIV2kr */
 			{
-				Uint16 a = (u->rst.dat[u->rst.ptr - 1] | (u->rst.dat[u->rst.ptr - 2] << 8)), b = (u->rst.dat[u->rst.ptr - 3] | (u->rst.dat[u->rst.ptr - 4] << 8));
+				Uint16 a = (u->rst.dat[rptr - 1] | (u->rst.dat[rptr - 2] << 8)), b = (u->rst.dat[rptr - 3] | (u->rst.dat[rptr - 4] << 8));
 				if(a == 0) {
 					u->rst.error = 3;
 #ifndef NO_STACK_CHECKS
@@ -3925,100 +4337,114 @@ uxn_eval(Uxn *u, Uint16 vec)
 #endif
 					a = 1;
 				}
-				u->rst.dat[u->rst.ptr] = (b / a) >> 8;
-				u->rst.dat[u->rst.ptr + 1] = (b / a) & 0xff;
+				u->rst.dat[rptr] = (b / a) >> 8;
+				u->rst.dat[rptr + 1] = (b / a) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xfc: /* AND2kr */
+			NEXT;
+		CASE(0xfc) /* AND2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr] = d & b;
-				u->rst.dat[u->rst.ptr + 1] = c & a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr] = d & b;
+				u->rst.dat[rptr + 1] = c & a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xfd: /* ORA2kr */
+			NEXT;
+		CASE(0xfd) /* ORA2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr] = d | b;
-				u->rst.dat[u->rst.ptr + 1] = c | a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr] = d | b;
+				u->rst.dat[rptr + 1] = c | a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xfe: /* EOR2kr */
+			NEXT;
+		CASE(0xfe) /* EOR2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1], b = u->rst.dat[u->rst.ptr - 2], c = u->rst.dat[u->rst.ptr - 3], d = u->rst.dat[u->rst.ptr - 4];
-				u->rst.dat[u->rst.ptr] = d ^ b;
-				u->rst.dat[u->rst.ptr + 1] = c ^ a;
+				Uint8 a = u->rst.dat[rptr - 1], b = u->rst.dat[rptr - 2], c = u->rst.dat[rptr - 3], d = u->rst.dat[rptr - 4];
+				u->rst.dat[rptr] = d ^ b;
+				u->rst.dat[rptr + 1] = c ^ a;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 4, 0)) {
+				if(__builtin_expect(rptr < 4, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
-		case 0xff: /* SFT2kr */
+			NEXT;
+		CASE(0xff) /* SFT2kr */
 			{
-				Uint8 a = u->rst.dat[u->rst.ptr - 1];
-				Uint16 b = (u->rst.dat[u->rst.ptr - 2] | (u->rst.dat[u->rst.ptr - 3] << 8));
-				u->rst.dat[u->rst.ptr] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
-				u->rst.dat[u->rst.ptr + 1] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
+				Uint8 a = u->rst.dat[rptr - 1];
+				Uint16 b = (u->rst.dat[rptr - 2] | (u->rst.dat[rptr - 3] << 8));
+				u->rst.dat[rptr] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) >> 8;
+				u->rst.dat[rptr + 1] = (b >> (a & 0x0f) << ((a & 0xf0) >> 4)) & 0xff;
 #ifndef NO_STACK_CHECKS
-				if(__builtin_expect(u->rst.ptr < 3, 0)) {
+				if(__builtin_expect(rptr < 3, 0)) {
 					u->rst.error = 1;
 					goto error;
 				}
-				if(__builtin_expect(u->rst.ptr > 253, 0)) {
+				if(__builtin_expect(rptr > 253, 0)) {
 					u->rst.error = 2;
 					goto error;
 				}
 #endif
-				u->rst.ptr += 2;
+				rptr += 2;
 			}
-			break;
+			NEXT;
 #pragma GCC diagnostic pop
 		}
 	}
+#ifdef THREADED_DISPATCH
+brk:
+#endif
+	u->ram.ptr = pc;
+	u->wst.ptr = wptr;
+	u->rst.ptr = rptr;
 	return 1;
+suspend:
+	u->ram.ptr = pc;
+	u->wst.ptr = wptr;
+	u->rst.ptr = rptr;
+	return UXN_SUSPENDED;
 #ifndef NO_STACK_CHECKS
 error:
+	u->ram.ptr = pc;
+	u->wst.ptr = wptr;
+	u->rst.ptr = rptr;
 	if(u->wst.error)
 		return uxn_halt(u, u->wst.error, "Working-stack", instr);
 	else
@@ -4033,7 +4459,11 @@ uxn_boot(Uxn *u)
 	char *cptr = (char *)u;
 	for(i = 0; i < sizeof(*u); i++)
 		cptr[i] = 0x00;
+#ifdef UXN_JIT
+	return uxn_jit_boot(u);
+#else
 	return 1;
+#endif
 }
 
 Device *
@@ -4046,3 +4476,22 @@ uxn_port(Uxn *u, Uint8 id, int (*talkfn)(Device *d, Uint8 b0, Uint8 w))
 	d->talk = talkfn;
 	return d;
 }
+
+int
+uxn_eval_steps(Uxn *u, Uint16 vec, unsigned int steps)
+{
+	if(!vec || u->dev[0].dat[0xf])
+		return 0;
+	u->ram.ptr = vec;
+	if(u->wst.ptr > 0xf8) u->wst.ptr = 0xf8;
+	return uxn_resume(u, steps);
+}
+
+int
+uxn_eval(Uxn *u, Uint16 vec)
+{
+	int ret = uxn_eval_steps(u, vec, 0x10000);
+	while(ret == UXN_SUSPENDED)
+		ret = uxn_resume(u, 0x10000);
+	return ret;
+}
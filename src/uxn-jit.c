@@ -0,0 +1,618 @@
+#if !defined(__x86_64__) || defined(_WIN32)
+#error "src/uxn-jit.c emits SysV x86-64 code, build without -DUXN_JIT"
+#endif
+
+#define _DEFAULT_SOURCE
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "uxn.h"
+
+/*
+Copyright (c) 2021 Devine Lu Linvega
+
+Permission to use, copy, modify, and distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE.
+*/
+
+/*
+Basic-block compiler to x86-64, used by src/uxn.c when built with -DUXN_JIT:
+
+	cc -DUXN_JIT src/uxn.c src/uxn-jit.c -DUXNASM_LIB src/uxnasm.c src/devices/file.c src/uxncli.c -lpthread -o bin/uxncli
+
+Starting from the program counter, straight-line code is translated up to and
+including the next jump, and cached by address. Stack offsets inside a block
+are known when it is translated, so the code addresses stack bytes relative
+to the pointers at entry, held in r8 and r9, and skips every stack check once
+the block's depth has been checked against the stacks. DEI, DEO, BRK and
+anything that would fault are left to the interpreter.
+
+Stores into translated code leave the block, drop the blocks covering the
+byte and keep it from being translated again. Memory written outside of
+translated code, by devices or the host, is caught by comparing a block with
+its source the first time it runs after the interpreter has run a BRK, a
+device port or a store. etc/jit-test.sh checks that every rom in projects/
+ends the same with and without it.
+*/
+
+#define MODE_SHORT 0x20
+#define MODE_RETURN 0x40
+#define MODE_KEEP 0x80
+
+#define MAXLEN 64
+#define MAXBLOCKS 0x4000
+#define CODESIZE 0x400000
+#define TAKEN 0x10000
+#define BARRIER 0x20000
+
+#define EAX 0
+#define ECX 1
+#define EDX 2
+#define ESI 6
+#define EDI 7
+#define R8 8
+#define R9 9
+#define NOINDEX 4
+
+#define WDAT (offsetof(Uxn, wst) + offsetof(Stack, dat))
+#define WPTR (offsetof(Uxn, wst) + offsetof(Stack, ptr))
+#define RDAT (offsetof(Uxn, rst) + offsetof(Stack, dat))
+#define RPTR (offsetof(Uxn, rst) + offsetof(Stack, ptr))
+#define RAM (offsetof(Uxn, ram) + offsetof(Memory, dat))
+
+typedef unsigned long (*Native)(Uxn *u, Uint8 *mark);
+
+typedef struct {
+	Uint16 addr, len;
+	int lo[2], hi[2];
+	unsigned long epoch;
+	Uint8 *code, src[MAXLEN];
+} Block;
+
+typedef struct Jit {
+	Uxn *u;
+	struct Jit *next;
+	Uint8 *code, *p, keep, last;
+	int nblocks, c[2], lo[2], hi[2], rd, ob;
+	unsigned long epoch;
+	Block *map[0x10000], blocks[MAXBLOCKS];
+	Uint8 mark[0x10001], written[0x10001];
+} Jit;
+
+static Block none;
+static Jit *jits;
+static pthread_mutex_t jitslock = PTHREAD_MUTEX_INITIALIZER;
+
+#pragma mark - Encoding
+
+static void
+byte(Jit *j, int b)
+{
+	*j->p++ = b;
+}
+
+static void
+imm32(Jit *j, unsigned int v)
+{
+	byte(j, v);
+	byte(j, v >> 8);
+	byte(j, v >> 16);
+	byte(j, v >> 24);
+}
+
+/* opc reg, [base + index + disp] */
+static void
+mem(Jit *j, int wide, int opc, int reg, int base, int index, int disp)
+{
+	int rex = 0x40 | (reg & 8) >> 1 | (index & 8) >> 2 | (base & 8) >> 3;
+	if(wide)
+		byte(j, 0x66);
+	if(rex != 0x40)
+		byte(j, rex);
+	if(opc > 0xff)
+		byte(j, opc >> 8);
+	byte(j, opc);
+	byte(j, 0x84 | (reg & 7) << 3);
+	byte(j, (index & 7) << 3 | (base & 7));
+	imm32(j, disp);
+}
+
+/* opc r/m, reg between two of eax, ecx and edx */
+static void
+rr(Jit *j, int opc, int rm, int reg)
+{
+	if(opc > 0xff)
+		byte(j, opc >> 8);
+	byte(j, opc);
+	byte(j, 0xc0 | reg << 3 | rm);
+}
+
+static void
+swap(Jit *j, int r)
+{
+	byte(j, 0x66), byte(j, 0xc1), byte(j, 0xc0 | r), byte(j, 0x08); /* rol r16, 8 */
+}
+
+static void
+ld(Jit *j, int r, int s, int o, int n)
+{
+	mem(j, 0, n == 2 ? 0x0fb7 : 0x0fb6, r, EDI, s ? R9 : R8, (s ? RDAT : WDAT) + o);
+	if(n == 2) swap(j, r);
+}
+
+static void
+st(Jit *j, int s, int o, int r, int n)
+{
+	if(n == 2) swap(j, r);
+	mem(j, n == 2, n == 2 ? 0x89 : 0x88, r, EDI, s ? R9 : R8, (s ? RDAT : WDAT) + o);
+	if(n == 2) swap(j, r);
+}
+
+static void
+lit(Jit *j, int s, int o, Uint8 v)
+{
+	mem(j, 0, 0xc6, 0, EDI, s ? R9 : R8, (s ? RDAT : WDAT) + o);
+	byte(j, v);
+}
+
+static void
+peek(Jit *j, int r, int a, int n)
+{
+	mem(j, 0, n == 2 ? 0x0fb7 : 0x0fb6, r, EDI, a, RAM);
+	if(n == 2) swap(j, r);
+}
+
+static void
+poke(Jit *j, int a, int r, int n)
+{
+	if(n == 2) swap(j, r);
+	mem(j, n == 2, n == 2 ? 0x89 : 0x88, r, EDI, a, RAM);
+}
+
+/* eax = next + (Sint8)al */
+static void
+relative(Jit *j, Uint16 next)
+{
+	rr(j, 0x0fbe, EAX, EAX);
+	byte(j, 0x05), imm32(j, next);
+	rr(j, 0x0fb7, EAX, EAX);
+}
+
+#pragma mark - Translation
+
+static int
+pop(Jit *j, int s, int n)
+{
+	j->rd -= n;
+	if(j->rd < j->lo[s]) j->lo[s] = j->rd;
+	return j->rd;
+}
+
+static int
+push(Jit *j, int s, int n)
+{
+	int o;
+	if(j->ob < -0x100) j->ob = j->keep ? j->c[s] : j->rd;
+	o = j->ob;
+	j->ob += n;
+	return o;
+}
+
+static int
+pushd(Jit *j, int d, int n)
+{
+	int o = j->c[d];
+	j->c[d] += n;
+	if(j->c[d] > j->hi[d]) j->hi[d] = j->c[d];
+	return o;
+}
+
+static void
+finish(Jit *j, int s)
+{
+	if(j->ob < -0x100) j->ob = j->keep ? j->c[s] : j->rd;
+	j->c[s] = j->ob;
+	if(j->c[s] > j->hi[s]) j->hi[s] = j->c[s];
+}
+
+/* move the stack pointers to where the block has got to */
+static void
+settle(Jit *j)
+{
+	if(j->c[0]) mem(j, 0, 0x80, 0, EDI, NOINDEX, WPTR), byte(j, j->c[0]);
+	if(j->c[1]) mem(j, 0, 0x80, 0, EDI, NOINDEX, RPTR), byte(j, j->c[1]);
+}
+
+static void
+leave(Jit *j, Uint16 pc)
+{
+	settle(j);
+	byte(j, 0xb8), imm32(j, pc);
+	byte(j, 0xc3);
+}
+
+static void
+jump(Jit *j, int s, int n, Uint16 next)
+{
+	if(n == 1) relative(j, next);
+	finish(j, s);
+	settle(j);
+	byte(j, 0x0d), imm32(j, TAKEN);
+}
+
+/* a short at 0xffff wraps to 0x0000, the interpreter takes it */
+static void
+wrap(Jit *j, int n, Uint16 pc)
+{
+	Uint8 *skip;
+	if(n != 2)
+		return;
+	byte(j, 0x3d), imm32(j, 0xffff); /* cmp eax, 0xffff */
+	byte(j, 0x75), byte(j, 0), skip = j->p;
+	leave(j, pc);
+	skip[-1] = j->p - skip;
+}
+
+/* leave the block if the store at eax hit translated code */
+static void
+barrier(Jit *j, int s, int n, Uint16 next)
+{
+	Uint8 *skip;
+	finish(j, s);
+	mem(j, 0, 0x8a, EDX, ESI, EAX, 0);
+	if(n == 2) mem(j, 0, 0x0a, EDX, ESI, EAX, 1);
+	rr(j, 0x84, EDX, EDX);
+	byte(j, 0x74), byte(j, 0), skip = j->p;
+	settle(j);
+	byte(j, 0x48), byte(j, 0xc1), byte(j, 0xe0), byte(j, 32); /* shl rax, 32 */
+	byte(j, 0x48), byte(j, 0x0d), imm32(j, next | BARRIER);
+	byte(j, 0xc3);
+	skip[-1] = j->p - skip;
+}
+
+static int
+emit(Jit *j, Uint8 *ram, Uint8 instr, Uint16 pc)
+{
+	int s = !!(instr & MODE_RETURN), n = instr & MODE_SHORT ? 2 : 1, a, b, c;
+	Uint16 next = pc + 1;
+	Uint8 *skip;
+	j->keep = instr & MODE_KEEP;
+	j->rd = j->c[s];
+	j->ob = -0x200;
+	switch(instr & 0x1f) {
+	case 0x00: /* LIT */
+		a = push(j, s, n);
+		lit(j, s, a, ram[pc + 1]);
+		if(n == 2) lit(j, s, a + 1, ram[pc + 2]);
+		break;
+	case 0x01: /* INC */
+		ld(j, EAX, s, pop(j, s, n), n);
+		byte(j, 0xff), byte(j, 0xc0);
+		st(j, s, push(j, s, n), EAX, n);
+		break;
+	case 0x02: /* POP */
+		pop(j, s, n);
+		break;
+	case 0x03: /* DUP */
+		ld(j, EAX, s, pop(j, s, n), n);
+		st(j, s, push(j, s, n), EAX, n);
+		st(j, s, push(j, s, n), EAX, n);
+		break;
+	case 0x04: /* NIP */
+		a = pop(j, s, n);
+		pop(j, s, n);
+		ld(j, EAX, s, a, n);
+		st(j, s, push(j, s, n), EAX, n);
+		break;
+	case 0x05: /* SWP */
+		a = pop(j, s, n), b = pop(j, s, n);
+		ld(j, EAX, s, a, n), ld(j, ECX, s, b, n);
+		st(j, s, push(j, s, n), EAX, n);
+		st(j, s, push(j, s, n), ECX, n);
+		break;
+	case 0x06: /* OVR */
+		a = pop(j, s, n), b = pop(j, s, n);
+		ld(j, EAX, s, a, n), ld(j, ECX, s, b, n);
+		st(j, s, push(j, s, n), ECX, n);
+		st(j, s, push(j, s, n), EAX, n);
+		st(j, s, push(j, s, n), ECX, n);
+		break;
+	case 0x07: /* ROT */
+		a = pop(j, s, n), b = pop(j, s, n), c = pop(j, s, n);
+		ld(j, EAX, s, a, n), ld(j, ECX, s, b, n), ld(j, EDX, s, c, n);
+		st(j, s, push(j, s, n), ECX, n);
+		st(j, s, push(j, s, n), EAX, n);
+		st(j, s, push(j, s, n), EDX, n);
+		break;
+	case 0x08: /* EQU */
+	case 0x09: /* NEQ */
+	case 0x0a: /* GTH */
+	case 0x0b: /* LTH */
+		a = pop(j, s, n), b = pop(j, s, n);
+		ld(j, ECX, s, a, n), ld(j, EAX, s, b, n);
+		rr(j, 0x39, EAX, ECX);
+		byte(j, 0x0f), byte(j, "\x94\x95\x97\x92"[(instr & 0x1f) - 0x08]), byte(j, 0xc0);
+		rr(j, 0x0fb6, EAX, EAX);
+		st(j, s, push(j, s, 1), EAX, 1);
+		break;
+	case 0x0c: /* JMP */
+		ld(j, EAX, s, pop(j, s, n), n);
+		jump(j, s, n, next);
+		byte(j, 0xc3);
+		return 1;
+	case 0x0d: /* JNZ */
+		a = pop(j, s, n), b = pop(j, s, 1);
+		ld(j, EAX, s, a, n), ld(j, ECX, s, b, 1);
+		jump(j, s, n, next);
+		byte(j, 0xba), imm32(j, next);
+		rr(j, 0x84, ECX, ECX);
+		rr(j, 0x0f44, EDX, EAX);
+		byte(j, 0xc3);
+		return 1;
+	case 0x0e: /* JSR */
+		ld(j, EAX, s, pop(j, s, n), n);
+		a = pushd(j, !s, 2);
+		lit(j, !s, a, next >> 8), lit(j, !s, a + 1, next);
+		jump(j, s, n, next);
+		byte(j, 0xc3);
+		return 1;
+	case 0x0f: /* STH */
+		ld(j, EAX, s, pop(j, s, n), n);
+		st(j, !s, pushd(j, !s, n), EAX, n);
+		break;
+	case 0x10: /* LDZ */
+	case 0x12: /* LDR */
+	case 0x14: /* LDA */
+		a = (instr & 0x1f) == 0x14 ? 2 : 1;
+		ld(j, EAX, s, pop(j, s, a), a);
+		if((instr & 0x1f) == 0x12) relative(j, next);
+		wrap(j, n, pc);
+		peek(j, ECX, EAX, n);
+		st(j, s, push(j, s, n), ECX, n);
+		break;
+	case 0x11: /* STZ */
+	case 0x13: /* STR */
+	case 0x15: /* STA */
+		a = (instr & 0x1f) == 0x15 ? 2 : 1;
+		a = pop(j, s, a), b = pop(j, s, n);
+		ld(j, EAX, s, a, (instr & 0x1f) == 0x15 ? 2 : 1);
+		if((instr & 0x1f) == 0x13) relative(j, next);
+		wrap(j, n, pc);
+		ld(j, ECX, s, b, n);
+		poke(j, EAX, ECX, n);
+		barrier(j, s, n, next);
+		return 0;
+	case 0x18: /* ADD */
+	case 0x19: /* SUB */
+	case 0x1a: /* MUL */
+	case 0x1c: /* AND */
+	case 0x1d: /* ORA */
+	case 0x1e: /* EOR */
+		a = pop(j, s, n), b = pop(j, s, n);
+		ld(j, ECX, s, a, n), ld(j, EAX, s, b, n);
+		switch(instr & 0x1f) {
+		case 0x18: rr(j, 0x01, EAX, ECX); break;
+		case 0x19: rr(j, 0x29, EAX, ECX); break;
+		case 0x1a: rr(j, 0x0faf, ECX, EAX); break;
+		case 0x1c: rr(j, 0x21, EAX, ECX); break;
+		case 0x1d: rr(j, 0x09, EAX, ECX); break;
+		case 0x1e: rr(j, 0x31, EAX, ECX); break;
+		}
+		st(j, s, push(j, s, n), EAX, n);
+		break;
+	case 0x1b: /* DIV */
+		a = pop(j, s, n), b = pop(j, s, n);
+		ld(j, ECX, s, a, n), ld(j, EAX, s, b, n);
+		/* the interpreter reports division by zero */
+		rr(j, 0x85, ECX, ECX);
+		byte(j, 0x75), byte(j, 0), skip = j->p;
+		leave(j, pc);
+		skip[-1] = j->p - skip;
+		rr(j, 0x31, EDX, EDX);
+		byte(j, 0xf7), byte(j, 0xf1);
+		st(j, s, push(j, s, n), EAX, n);
+		break;
+	case 0x1f: /* SFT */
+		a = pop(j, s, 1), b = pop(j, s, n);
+		ld(j, EDX, s, a, 1), ld(j, EAX, s, b, n);
+		rr(j, 0x89, ECX, EDX);
+		byte(j, 0x83), byte(j, 0xe1), byte(j, 0x0f);
+		byte(j, 0xd3), byte(j, 0xe8);
+		rr(j, 0x89, ECX, EDX);
+		byte(j, 0xc1), byte(j, 0xe9), byte(j, 0x04);
+		byte(j, 0xd3), byte(j, 0xe0);
+		st(j, s, push(j, s, n), EAX, n);
+		break;
+	}
+	finish(j, s);
+	return 0;
+}
+
+static void
+flush(Jit *j)
+{
+	j->nblocks = 0;
+	j->p = j->code;
+	memset(j->map, 0, sizeof(j->map));
+	memset(j->mark, 0, sizeof(j->mark));
+}
+
+static void
+drop(Jit *j, Block *b)
+{
+	j->map[b->addr] = NULL;
+	b->len = 0;
+}
+
+static Block *
+translate(Jit *j, Uint8 *ram, Uint16 addr)
+{
+	Block *b;
+	unsigned int pc = addr, len, i;
+	int jumped = 0;
+	Uint8 instr;
+	if(j->nblocks == MAXBLOCKS || j->code + CODESIZE - j->p < MAXLEN * 128)
+		flush(j);
+	b = &j->blocks[j->nblocks];
+	b->code = j->p;
+	j->c[0] = j->c[1] = j->lo[0] = j->lo[1] = j->hi[0] = j->hi[1] = 0;
+	mem(j, 0, 0x0fb6, R8, EDI, NOINDEX, WPTR);
+	mem(j, 0, 0x0fb6, R9, EDI, NOINDEX, RPTR);
+	for(;;) {
+		instr = ram[pc];
+		len = instr & 0x1f ? 1 : instr & MODE_SHORT ? 3 : 2;
+		if(!instr || (instr & 0x1e) == 0x16 || pc + len > 0x10000 || pc + len - addr > MAXLEN)
+			break;
+		for(i = 0; i < len && !j->written[pc + i]; i++);
+		if(i < len)
+			break;
+		jumped = emit(j, ram, instr, pc);
+		pc += len;
+		if(jumped)
+			break;
+	}
+	if(pc == addr) {
+		j->p = b->code;
+		return j->map[addr] = &none;
+	}
+	if(!jumped)
+		leave(j, pc);
+	b->addr = addr;
+	b->len = pc - addr;
+	b->epoch = j->epoch;
+	memcpy(b->src, &ram[addr], b->len);
+	memset(&j->mark[addr], 1, b->len);
+	memcpy(b->lo, j->lo, sizeof(b->lo));
+	memcpy(b->hi, j->hi, sizeof(b->hi));
+	j->nblocks++;
+	return j->map[addr] = b;
+}
+
+/* a translated byte was written to, translate around it from now on */
+static void
+invalidate(Jit *j, unsigned int addr)
+{
+	int i;
+	unsigned int a;
+	for(a = addr; a <= addr + 1; a++) {
+		if(!j->mark[a])
+			continue;
+		j->mark[a] = 0;
+		j->written[a] = 1;
+		for(i = 0; i < j->nblocks; i++)
+			if(j->blocks[i].len && a - j->blocks[i].addr < j->blocks[i].len)
+				drop(j, &j->blocks[i]);
+	}
+}
+
+/* could memory have changed since the interpreter ran instr */
+static int
+writes(Uint8 instr)
+{
+	switch(instr & 0x1f) {
+	case 0x00: return !instr; /* BRK, the host had a turn */
+	case 0x11: /* STZ */
+	case 0x13: /* STR */
+	case 0x15: /* STA */
+	case 0x16: /* DEI */
+	case 0x17: /* DEO */ return 1;
+	}
+	return 0;
+}
+
+#pragma mark - Core
+
+int
+uxn_jit(Uxn *u, unsigned int *steps)
+{
+	Jit *j = u->jit;
+	Block *b;
+	unsigned long r;
+	if(!j || u->wst.error || u->rst.error)
+		return 0;
+	if(writes(j->last))
+		j->epoch++;
+	for(;;) {
+		b = j->map[u->ram.ptr];
+		if(b && b != &none && b->epoch != j->epoch) {
+			if(memcmp(b->src, &u->ram.dat[b->addr], b->len)) {
+				drop(j, b);
+				b = NULL;
+			} else
+				b->epoch = j->epoch;
+		}
+		if(!b)
+			b = translate(j, u->ram.dat, u->ram.ptr);
+		if(b == &none
+			|| u->wst.ptr + b->lo[0] < 0 || u->wst.ptr + b->hi[0] > 0xff
+			|| u->rst.ptr + b->lo[1] < 0 || u->rst.ptr + b->hi[1] > 0xff) {
+			/* the interpreter runs the next instruction */
+			j->last = u->ram.dat[u->ram.ptr];
+			return 0;
+		}
+		r = ((Native)b->code)(u, j->mark);
+		u->ram.ptr = r;
+		if(r == b->addr) {
+			/* the block left before its first instruction */
+			j->last = u->ram.dat[u->ram.ptr];
+			return 0;
+		}
+		if(r & BARRIER)
+			invalidate(j, r >> 32);
+		if(r & TAKEN && !--*steps) {
+			j->last = 0;
+			return UXN_SUSPENDED;
+		}
+	}
+}
+
+int
+uxn_jit_boot(Uxn *u)
+{
+	Jit *j;
+	pthread_mutex_lock(&jitslock);
+	for(j = jits; j && j->u != u; j = j->next)
+		;
+	if(!j && (j = calloc(1, sizeof(Jit)))) {
+		j->code = mmap(NULL, CODESIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(j->code == MAP_FAILED) {
+			free(j);
+			j = NULL;
+		} else {
+			j->u = u;
+			j->next = jits;
+			jits = j;
+		}
+	}
+	pthread_mutex_unlock(&jitslock);
+	if(j) {
+		flush(j);
+		j->last = 0;
+		memset(j->written, 0, sizeof(j->written));
+	}
+	u->jit = j;
+	return 1;
+}
+
+void
+uxn_jit_free(Uxn *u)
+{
+	Jit *j, **p;
+	pthread_mutex_lock(&jitslock);
+	for(p = &jits; (j = *p) && j->u != u; p = &j->next)
+		;
+	if(j)
+		*p = j->next;
+	pthread_mutex_unlock(&jitslock);
+	if(j) {
+		munmap(j->code, CODESIZE);
+		free(j);
+	}
+	u->jit = NULL;
+}
@@ -20,20 +20,9 @@ WITH REGARD TO THIS SOFTWARE.
 
 /* clang-format off */
 
-/* Utilities */
-static void   (*push)(Stack *s, Uint16 a);
-static Uint16 (*pop8)(Stack *s);
-static Uint16 (*pop)(Stack *s);
-static void   (*poke)(Uint8 *m, Uint16 a, Uint16 b);
-static Uint16 (*peek)(Uint8 *m, Uint16 a);
-static int    (*devw)(Device *d, Uint8 a, Uint16 b);
-static Uint16 (*devr)(Device *d, Uint8 a);
-static void   (*warp)(Uxn *u, Uint16 a);
-static void   (*pull)(Uxn *u);
 /* byte mode */
 static void   push8(Stack *s, Uint16 a) { if(s->ptr == 0xff) { s->error = 2; return; } s->dat[s->ptr++] = a; }
-static Uint16 pop8k(Stack *s) { if(s->kptr == 0) { s->error = 1; return 0; } return s->dat[--s->kptr]; }
-static Uint16 pop8d(Stack *s) { if(s->ptr == 0) { s->error = 1; return 0; } return s->dat[--s->ptr]; }
+static Uint16 pop8(Stack *s, int keep) { Uint8 *p = keep ? &s->kptr : &s->ptr; if(*p == 0) { s->error = 1; return 0; } return s->dat[--*p]; }
 static void   poke8(Uint8 *m, Uint16 a, Uint16 b) { m[a] = b; }
 static Uint16 peek8(Uint8 *m, Uint16 a) { return m[a]; }
 static int    devw8(Device *d, Uint8 a, Uint16 b) { d->dat[a & 0xf] = b; return d->talk(d, a & 0x0f, 1); }
@@ -42,7 +31,7 @@ static void   warp8(Uxn *u, Uint16 a){ u->ram.ptr += (Sint8)a; }
 static void   pull8(Uxn *u){ push8(u->src, peek8(u->ram.dat, u->ram.ptr++)); }
 /* short mode */
 static void   push16(Stack *s, Uint16 a) { push8(s, a >> 8); push8(s, a); }
-static Uint16 pop16(Stack *s) { Uint8 a = pop8(s), b = pop8(s); return a + (b << 8); }
+static Uint16 pop16(Stack *s, int keep) { Uint8 a = pop8(s, keep), b = pop8(s, keep); return a + (b << 8); }
 	   void   poke16(Uint8 *m, Uint16 a, Uint16 b) { poke8(m, a, b >> 8); poke8(m, a + 1, b); }
 	   Uint16 peek16(Uint8 *m, Uint16 a) { return (peek8(m, a) << 8) + peek8(m, a + 1); }
 static int    devw16(Device *d, Uint8 a, Uint16 b) { return devw8(d, a, b >> 8) && devw8(d, a + 1, b); }
@@ -50,18 +39,194 @@ static Uint16 devr16(Device *d, Uint8 a) { return (devr8(d, a) << 8) + devr8(d,
 static void   warp16(Uxn *u, Uint16 a){ u->ram.ptr = a; }
 static void   pull16(Uxn *u){ push16(u->src, peek16(u->ram.dat, u->ram.ptr++)); u->ram.ptr++; }
 
+/* clang-format on */
+
+#ifdef UXN_STATS
+
+#pragma mark - Stats
+
+/* opcodes run one after another from adjacent addresses are candidates for
+   fusing, they are counted by pairs and triples across every Uxn */
+
+static unsigned long pairs[0x10000];
+static struct { unsigned long key, count; } triples[0x10000];
+static unsigned int ntriples, chain;
+static Uint16 follow;
+static Uint8 last[2];
+
+static void
+count(Uint16 addr, Uint8 instr)
+{
+	unsigned long key, i;
+	if(addr != follow)
+		chain = 0;
+	/* literals carry their value inline */
+	follow = addr + 1 + ((instr & 0x1f) ? 0 : instr & MODE_SHORT ? 2 : 1);
+	if(chain > 0)
+		pairs[last[1] << 8 | instr]++;
+	if(chain > 1) {
+		key = (unsigned long)last[0] << 16 | last[1] << 8 | instr;
+		for(i = key * 2654435761UL & 0xffff; triples[i].count; i = (i + 1) & 0xffff)
+			if(triples[i].key == key)
+				break;
+		if(triples[i].count)
+			triples[i].count++;
+		else if(ntriples < 0xffff) {
+			ntriples++;
+			triples[i].key = key;
+			triples[i].count = 1;
+		}
+	}
+	last[0] = last[1];
+	last[1] = instr;
+	chain++;
+}
+
+void
+uxn_grams(void (*fn)(Uint8 *ops, int len, unsigned long count))
+{
+	Uint8 ops[3];
+	unsigned long i;
+	for(i = 0; i < 0x10000; i++) {
+		if(pairs[i]) {
+			ops[0] = i >> 8, ops[1] = i;
+			fn(ops, 2, pairs[i]);
+		}
+		if(triples[i].count) {
+			ops[0] = triples[i].key >> 16, ops[1] = triples[i].key >> 8, ops[2] = triples[i].key;
+			fn(ops, 3, triples[i].count);
+		}
+	}
+}
+
+#endif
+
+#ifdef UXN_PROFILE
+
+#pragma mark - Profile
+
+/* instructions are counted by opcode, by address and by call stack, across
+   every Uxn: a JSR enters a frame, a JMP2r to the address after it leaves */
+
+typedef struct {
+	Uint16 addr;
+	int parent;
+	unsigned long count;
+} Frame;
+
+static unsigned long opcounts[0x100], addrcounts[0x10000];
+static Frame frames[0x10000];
+static int nframes = 1, slots[0x20000], calls[0x100], depth;
+static Uint16 returns[0x100];
+
+static int
+callee(int parent, Uint16 addr)
+{
+	unsigned long i = ((unsigned long)parent * 0x10000 + addr) * 2654435761UL & 0x1ffff;
+	for(; slots[i]; i = (i + 1) & 0x1ffff)
+		if(frames[slots[i]].parent == parent && frames[slots[i]].addr == addr)
+			return slots[i];
+	if(nframes == 0x10000)
+		return parent;
+	frames[nframes].addr = addr;
+	frames[nframes].parent = parent;
+	return slots[i] = nframes++;
+}
+
+static void
+profile(Uint16 addr, Uint8 instr, Uint16 next)
+{
+	int i;
+	/* the first instruction of a vector is the root of its calls */
+	if(!depth) {
+		calls[0] = callee(0, addr);
+		depth = 1;
+	}
+	opcounts[instr]++;
+	addrcounts[addr]++;
+	frames[calls[depth - 1]].count++;
+	if((instr & 0x1f) == 0x0e && depth < 0x100) {
+		returns[depth] = addr + 1;
+		calls[depth] = callee(calls[depth - 1], next);
+		depth++;
+	} else if((instr & 0x5f) == 0x4c) {
+		for(i = depth - 1; i > 0; i--)
+			if(returns[i] == next) {
+				depth = i;
+				break;
+			}
+	}
+}
+
+void
+uxn_profile(unsigned long *ops, unsigned long *addrs, void (*fn)(Uint16 *calls, int depth, unsigned long count))
+{
+	Uint16 path[0x100];
+	int i, f, n, d;
+	for(i = 0; i < 0x100; i++)
+		ops[i] = opcounts[i];
+	for(i = 0; i < 0x10000; i++)
+		addrs[i] = addrcounts[i];
+	for(i = 1; i < nframes; i++) {
+		if(!frames[i].count)
+			continue;
+		for(n = 0, f = i; f; f = frames[f].parent)
+			n++;
+		for(d = n, f = i; f; f = frames[f].parent)
+			path[--d] = frames[f].addr;
+		fn(path, n, frames[i].count);
+	}
+}
+
+#endif
+
+/* clang-format off */
+
 #pragma mark - Core
 
+/* the mode bits of the instruction being run pick the helper */
+#define push(s, a) (instr & MODE_SHORT ? push16(s, a) : push8(s, a))
+#define pop8(s) pop8(s, instr & MODE_KEEP)
+#define pop16(s) pop16(s, instr & MODE_KEEP)
+#define pop(s) (instr & MODE_SHORT ? pop16(s) : pop8(s))
+#define poke(m, a, b) (instr & MODE_SHORT ? poke16(m, a, b) : poke8(m, a, b))
+#define peek(m, a) (instr & MODE_SHORT ? peek16(m, a) : peek8(m, a))
+#define devw(d, a, b) (instr & MODE_SHORT ? devw16(d, a, b) : devw8(d, a, b))
+#define devr(d, a) (instr & MODE_SHORT ? devr16(d, a) : devr8(d, a))
+#define warp(u, a) (instr & MODE_SHORT ? warp16(u, a) : warp8(u, a))
+#define pull(u) (instr & MODE_SHORT ? pull16(u) : pull8(u))
+/* only taken jumps are charged to the budget */
+#define jump(u, a) { warp(u, a); if(!--steps) goto suspend; }
+
 int
-uxn_eval(Uxn *u, Uint16 vec)
+uxn_resume(Uxn *u, unsigned int steps)
 {
 	Uint8 instr;
 	Uint16 a,b,c;
-	if(!vec || u->dev[0].dat[0xf])
-		return 0;
-	u->ram.ptr = vec;
-	if(u->wst.ptr > 0xf8) u->wst.ptr = 0xf8;
-	while((instr = u->ram.dat[u->ram.ptr++])) {
+#ifdef UXN_JIT
+	int ret;
+#endif
+#ifdef UXN_PROFILE
+	Uint16 at;
+#endif
+	for(;;) {
+#ifdef UXN_JIT
+		/* run what can be run natively, the rest is interpreted */
+		if((ret = uxn_jit(u, &steps)))
+			return ret;
+#endif
+		if(!(instr = u->ram.dat[u->ram.ptr++])) {
+#ifdef UXN_PROFILE
+			depth = 0;
+#endif
+			break;
+		}
+#ifdef UXN_STATS
+		count(u->ram.ptr - 1, instr);
+#endif
+#ifdef UXN_PROFILE
+		at = u->ram.ptr - 1;
+#endif
 		/* Return Mode */
 		if(instr & MODE_RETURN) {
 			u->src = &u->rst; 
@@ -71,24 +236,8 @@ uxn_eval(Uxn *u, Uint16 vec)
 			u->dst = &u->rst;
 		}
 		/* Keep Mode */
-		if(instr & MODE_KEEP) {
-			pop8 = pop8k;
+		if(instr & MODE_KEEP)
 			u->src->kptr = u->src->ptr;
-		} else {
-			pop8 = pop8d;
-		}
-		/* Short Mode */
-		if(instr & MODE_SHORT) {
-			push = push16; pop = pop16;
-			poke = poke16; peek = peek16;
-			devw = devw16; devr = devr16;
-			warp = warp16; pull = pull16;
-		} else {
-			push = push8; pop = pop8;
-			poke = poke8; peek = peek8;
-			devw = devw8; devr = devr8;
-			warp = warp8; pull = pull8;
-		}
 		switch(instr & 0x1f){
 			/* Stack */
 			case 0x00: /* LIT */ pull(u); break;
@@ -104,9 +253,9 @@ uxn_eval(Uxn *u, Uint16 vec)
 			case 0x09: /* NEQ */ a = pop(u->src), b = pop(u->src); push8(u->src, b != a); break;
 			case 0x0a: /* GTH */ a = pop(u->src), b = pop(u->src); push8(u->src, b > a); break;
 			case 0x0b: /* LTH */ a = pop(u->src), b = pop(u->src); push8(u->src, b < a); break;
-			case 0x0c: /* JMP */ a = pop(u->src); warp(u, a); break;
-			case 0x0d: /* JNZ */ a = pop(u->src); if(pop8(u->src)) warp(u, a); break;
-			case 0x0e: /* JSR */ a = pop(u->src); push16(u->dst, u->ram.ptr); warp(u, a); break;
+			case 0x0c: /* JMP */ a = pop(u->src); jump(u, a); break;
+			case 0x0d: /* JNZ */ a = pop(u->src); if(pop8(u->src)) jump(u, a); break;
+			case 0x0e: /* JSR */ a = pop(u->src); push16(u->dst, u->ram.ptr); jump(u, a); break;
 			case 0x0f: /* STH */ a = pop(u->src); push(u->dst, a); break;
 			/* Memory */
 			case 0x10: /* LDZ */ a = pop8(u->src); push(u->src, peek(u->ram.dat, a)); break;
@@ -127,10 +276,20 @@ uxn_eval(Uxn *u, Uint16 vec)
 			case 0x1e: /* EOR */ a = pop(u->src), b = pop(u->src); push(u->src, b ^ a); break;
 			case 0x1f: /* SFT */ a = pop8(u->src), b = pop(u->src); push(u->src, b >> (a & 0x0f) << ((a & 0xf0) >> 4)); break;
 		}
+#ifdef UXN_PROFILE
+		profile(at, instr, u->ram.ptr);
+#endif
 		if(u->wst.error) return uxn_halt(u, u->wst.error, "Working-stack", instr);
 		if(u->rst.error) return uxn_halt(u, u->rst.error, "Return-stack", instr);
 	}
 	return 1;
+suspend:
+#ifdef UXN_PROFILE
+	profile(at, instr, u->ram.ptr);
+#endif
+	if(u->wst.error) return uxn_halt(u, u->wst.error, "Working-stack", instr);
+	if(u->rst.error) return uxn_halt(u, u->rst.error, "Return-stack", instr);
+	return UXN_SUSPENDED;
 }
 
 /* clang-format on */
@@ -142,7 +301,11 @@ uxn_boot(Uxn *u)
 	char *cptr = (char *)u;
 	for(i = 0; i < sizeof(*u); i++)
 		cptr[i] = 0x00;
+#ifdef UXN_JIT
+	return uxn_jit_boot(u);
+#else
 	return 1;
+#endif
 }
 
 Device *
@@ -155,3 +318,22 @@ uxn_port(Uxn *u, Uint8 id, int (*talkfn)(Device *d, Uint8 b0, Uint8 w))
 	d->talk = talkfn;
 	return d;
 }
+
+int
+uxn_eval_steps(Uxn *u, Uint16 vec, unsigned int steps)
+{
+	if(!vec || u->dev[0].dat[0xf])
+		return 0;
+	u->ram.ptr = vec;
+	if(u->wst.ptr > 0xf8) u->wst.ptr = 0xf8;
+	return uxn_resume(u, steps);
+}
+
+int
+uxn_eval(Uxn *u, Uint16 vec)
+{
+	int ret = uxn_eval_steps(u, vec, 0x10000);
+	while(ret == UXN_SUSPENDED)
+		ret = uxn_resume(u, 0x10000);
+	return ret;
+}
@@ -15,6 +15,7 @@ typedef unsigned short Uint16;
 typedef signed short Sint16;
 
 #define PAGE_PROGRAM 0x0100
+#define UXN_SUSPENDED 2
 
 typedef struct {
 	Uint8 ptr, kptr, error;
@@ -37,6 +38,7 @@ typedef struct Uxn {
 	Stack wst, rst, *src, *dst;
 	Memory ram;
 	Device dev[16];
+	void *jit;
 } Uxn;
 
 struct Uxn;
@@ -46,5 +48,22 @@ Uint16 peek16(Uint8 *m, Uint16 a);
 
 int uxn_boot(Uxn *c);
 int uxn_eval(Uxn *u, Uint16 vec);
+/* like uxn_eval, but gives up with UXN_SUSPENDED once steps (at least 1)
+   jumps and subroutine calls have been taken, uxn_resume carries on */
+int uxn_eval_steps(Uxn *u, Uint16 vec, unsigned int steps);
+int uxn_resume(Uxn *u, unsigned int steps);
 int uxn_halt(Uxn *u, Uint8 error, char *name, int id);
+/* src/uxn-jit.c or the output of src/uxn2c.c, called by src/uxn.c when built
+   with -DUXN_JIT, uxn_jit returns 0 to have the next instruction interpreted
+   or what uxn_resume should return */
+int uxn_jit(Uxn *u, unsigned int *steps);
+int uxn_jit_boot(Uxn *u);
+void uxn_jit_free(Uxn *u); /* releases what uxn_jit_boot made, before u is freed */
+/* src/uxn.c built with -DUXN_STATS counts the opcodes run back to back, fn
+   gets every pair and triple seen with how often it ran */
+void uxn_grams(void (*fn)(Uint8 *ops, int len, unsigned long count));
+/* src/uxn.c built with -DUXN_PROFILE fills ops and addrs with how often each
+   opcode and address ran, fn gets every call stack with the instructions run
+   at its top, from the vector down */
+void uxn_profile(unsigned long *ops, unsigned long *addrs, void (*fn)(Uint16 *calls, int depth, unsigned long count));
 Device *uxn_port(Uxn *u, Uint8 id, int (*talkfn)(Device *, Uint8, Uint8));
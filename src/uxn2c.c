@@ -0,0 +1,856 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/*
+Copyright (c) 2021 Devine Lu Linvega
+
+Permission to use, copy, modify, and distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE.
+*/
+
+/*
+Ahead-of-time translator from a rom to C, the output takes the place of
+src/uxn-jit.c in a build with -DUXN_JIT:
+
+	bin/uxn2c bin/life.rom bin/life.c
+	cc -DUXN_JIT -Isrc src/uxn.c bin/life.c -DUXNASM_LIB src/uxnasm.c src/devices/file.c src/uxncli.c -lpthread -o bin/life
+
+Basic blocks are found by following literal jumps, subroutine calls and
+vectors written to devices, from the reset vector. Each becomes a function
+which keeps the stack bytes it touches in locals, and calls the devices
+itself. The rom is still loaded as usual: a block only runs while the memory
+holds what it was translated from, so jumps to unknown addresses, rewritten
+code and other roms are left to the interpreter.
+
+With the symbols uxnasm writes next to the rom, in input.rom.sym, literals
+are folded into the code unless a label points into them. Without symbols,
+every literal is read from memory in case it was patched.
+*/
+
+#define TRIM 0x0100
+#define MAXLEN 64
+#define MAXBLOCKS 0x4000
+#define MAXTEMPS 0x400
+
+typedef unsigned char Uint8;
+typedef signed char Sint8;
+typedef unsigned short Uint16;
+
+typedef struct {
+	int t;
+	char part, dirty; /* k: constant t, b: byte temp, h, l: halves of a short temp, m: in memory */
+} Atom;
+
+typedef struct {
+	Atom b[2];
+	int n;
+	char s[64];
+} Val;
+
+typedef struct {
+	char name;
+	int c, lo, hi;
+	Atom a[0x200]; /* by offset from the pointer at entry, plus 0x100 */
+} Sim;
+
+typedef struct {
+	Uint8 ram[0x10000], leader[0x10000], known[0x10000], fixed[0x10000];
+	char *name[0x10000], pool[0x40000];
+	int length, nblocks, nsyms, devices, stores, guessing;
+	Uint16 blocks[MAXBLOCKS];
+} Rom;
+
+Rom p;
+static Sim st[2];
+static char body[0x40000], live[0x40000], tshort[MAXTEMPS], dead[MAXTEMPS];
+static int guess, start, end, blen, ntemps, tdef[MAXTEMPS], tend[MAXTEMPS], uses[MAXTEMPS];
+
+/* clang-format off */
+
+static char ops[][4] = {
+	"LIT", "INC", "POP", "DUP", "NIP", "SWP", "OVR", "ROT",
+	"EQU", "NEQ", "GTH", "LTH", "JMP", "JCN", "JSR", "STH",
+	"LDZ", "STZ", "LDR", "STR", "LDA", "STA", "DEI", "DEO",
+	"ADD", "SUB", "MUL", "DIV", "AND", "ORA", "EOR", "SFT"
+};
+
+static char *runtime[] = {
+	"static int",
+	"valid(Uint8 *m, const Block *b)",
+	"{",
+	"	unsigned int i;",
+	"	if(b->whole)",
+	"		return !memcmp(&m[b->addr], &rom[b->addr - TRIM], b->len);",
+	"	for(i = b->addr; i < b->addr + b->len; i++)",
+	"		if(KNOWN(i) && m[i] != rom[i - TRIM])",
+	"			return 0;",
+	"	return 1;",
+	"}",
+	"",
+	"static int",
+	"writes(Uint8 instr)",
+	"{",
+	"	switch(instr & 0x1f) {",
+	"	case 0x00: return !instr; /* BRK, the host had a turn */",
+	"	case 0x11: /* STZ */",
+	"	case 0x13: /* STR */",
+	"	case 0x15: /* STA */",
+	"	case 0x16: /* DEI */",
+	"	case 0x17: /* DEO */ return 1;",
+	"	}",
+	"	return 0;",
+	"}",
+	"",
+	"int",
+	"uxn_jit(Uxn *u, unsigned int *steps)",
+	"{",
+	"	Aot *s = u->jit;",
+	"	const Block *b;",
+	"	unsigned long r;",
+	"	unsigned int i;",
+	"	if(!s || u->wst.error || u->rst.error)",
+	"		return 0;",
+	"	if(writes(s->last))",
+	"		s->epoch++;",
+	"	for(;;) {",
+	"		i = u->ram.ptr - TRIM;",
+	"		if(i >= LENGTH || !entry[i])",
+	"			break;",
+	"		b = &blocks[entry[i] - 1];",
+	"		if(b->guess || s->seen[b - blocks] != s->epoch) {",
+	"			if(!valid(u->ram.dat, b))",
+	"				break;",
+	"			s->seen[b - blocks] = s->epoch;",
+	"		}",
+	"		r = b->run(u);",
+	"		u->ram.ptr = r;",
+	"		if(r & HALT) {",
+	"			s->last = 0;",
+	"			return 1;",
+	"		}",
+	"		if(r & INTERP)",
+	"			break;",
+	"		if(r & WRITE)",
+	"			s->epoch++;",
+	"		if(r & TAKEN && !--*steps) {",
+	"			s->last = 0;",
+	"			return UXN_SUSPENDED;",
+	"		}",
+	"	}",
+	"	/* the interpreter runs the next instruction */",
+	"	s->last = u->ram.dat[u->ram.ptr];",
+	"	return 0;",
+	"}",
+	"",
+	"int",
+	"uxn_jit_boot(Uxn *u)",
+	"{",
+	"	Aot *s;",
+	"	pthread_mutex_lock(&aotslock);",
+	"	for(s = aots; s && s->u != u; s = s->next)",
+	"		;",
+	"	if(!s && (s = calloc(1, sizeof(Aot)))) {",
+	"		s->u = u;",
+	"		s->next = aots;",
+	"		aots = s;",
+	"	}",
+	"	pthread_mutex_unlock(&aotslock);",
+	"	if(s)",
+	"		s->last = 0;",
+	"	u->jit = s;",
+	"	return 1;",
+	"}",
+	"",
+	"void",
+	"uxn_jit_free(Uxn *u)",
+	"{",
+	"	Aot *s, **p;",
+	"	pthread_mutex_lock(&aotslock);",
+	"	for(p = &aots; (s = *p) && s->u != u; p = &s->next)",
+	"		;",
+	"	if(s)",
+	"		*p = s->next;",
+	"	pthread_mutex_unlock(&aotslock);",
+	"	free(s);",
+	"	u->jit = NULL;",
+	"}",
+	NULL
+};
+
+static int   size(Uint8 instr) { return instr && !(instr & 0x1f) ? (instr & 0x20 ? 3 : 2) : 1; }
+static int   peek16(Uint16 a) { return p.ram[a] << 8 | p.ram[(Uint16)(a + 1)]; }
+static int   ends(Uint8 instr) { return !instr || ((instr & 0x1f) >= 0x0c && (instr & 0x1f) <= 0x0e) || (instr & 0x1f) == 0x17; }
+static int   isword(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; }
+
+/* clang-format on */
+
+#pragma mark - Helpers
+
+static int
+error(char *name, char *msg)
+{
+	fprintf(stderr, "%s: %s\n", name, msg);
+	return 0;
+}
+
+static void
+say(char *fmt, ...)
+{
+	va_list ap;
+	va_start(ap, fmt);
+	blen += vsprintf(body + blen, fmt, ap);
+	va_end(ap);
+}
+
+static char *
+atom(Atom a, char *buf)
+{
+	switch(a.part) {
+	case 'k': sprintf(buf, "0x%02x", a.t); break;
+	case 'b': sprintf(buf, "t%d", a.t); break;
+	case 'h': sprintf(buf, "(t%d >> 8)", a.t); break;
+	default: sprintf(buf, "(t%d & 0xff)", a.t);
+	}
+	return buf;
+}
+
+static Val
+describe(Val v)
+{
+	char x[32], y[32];
+	if(v.n == 1)
+		atom(v.b[0], v.s);
+	else if(v.b[0].part == 'h' && v.b[1].part == 'l' && v.b[0].t == v.b[1].t)
+		sprintf(v.s, "t%d", v.b[0].t);
+	else if(v.b[0].part == 'k' && v.b[1].part == 'k')
+		sprintf(v.s, "0x%04x", v.b[0].t << 8 | v.b[1].t);
+	else
+		sprintf(v.s, "(%s << 8 | %s)", atom(v.b[0], x), atom(v.b[1], y));
+	return v;
+}
+
+static Val
+konst(int n, int k)
+{
+	Val v;
+	v.n = n;
+	v.b[0].part = v.b[1].part = 'k';
+	v.b[0].t = n == 2 ? k >> 8 & 0xff : k & 0xff;
+	v.b[1].t = k & 0xff;
+	return describe(v);
+}
+
+static Val
+temp(int n, char *cast, char *fmt, va_list ap)
+{
+	Val v;
+	int t = ntemps++;
+	tshort[t] = n == 2;
+	tdef[t] = blen;
+	say("\tt%d = %s", t, cast);
+	blen += vsprintf(body + blen, fmt, ap);
+	say("%s;\n", *cast ? ")" : "");
+	tend[t] = blen;
+	v.n = n;
+	v.b[0].t = v.b[1].t = t;
+	v.b[0].part = n == 2 ? 'h' : 'b';
+	v.b[1].part = 'l';
+	return describe(v);
+}
+
+static Val
+value(int n, char *fmt, ...)
+{
+	Val v;
+	va_list ap;
+	va_start(ap, fmt);
+	v = temp(n, "", fmt, ap);
+	va_end(ap);
+	return v;
+}
+
+static Val
+result(int n, char *fmt, ...)
+{
+	Val v;
+	va_list ap;
+	va_start(ap, fmt);
+	v = temp(n, n == 2 ? "(Uint16)(" : "(Uint8)(", fmt, ap);
+	va_end(ap);
+	return v;
+}
+
+static Val
+compare(char *op, int same, Val b, Val a)
+{
+	/* DUP EQU and the like, written out they would be warned about */
+	if(!strcmp(b.s, a.s))
+		return konst(1, same);
+	return value(1, "%s %s %s", b.s, op, a.s);
+}
+
+#pragma mark - Stacks
+
+static Atom
+take(Sim *s, int *c)
+{
+	Atom *a = &s->a[--*c + 0x100];
+	if(*c < s->lo)
+		s->lo = *c;
+	if(a->part == 'm') {
+		Val v = value(1, "%c[%d]", s->name, *c);
+		a->t = v.b[0].t;
+		a->part = 'b';
+	}
+	return *a;
+}
+
+static void
+drop(Sim *s, int *c, int n)
+{
+	if((*c -= n) < s->lo)
+		s->lo = *c;
+}
+
+static Val
+pop(Sim *s, int *c, int n)
+{
+	Val v;
+	v.n = n;
+	if(n == 2)
+		v.b[1] = take(s, c);
+	v.b[0] = take(s, c);
+	return describe(v);
+}
+
+static void
+put(Sim *s, Atom a)
+{
+	a.dirty = 1;
+	s->a[s->c++ + 0x100] = a;
+	if(s->c > s->hi)
+		s->hi = s->c;
+}
+
+static void
+push(Sim *s, Val v)
+{
+	put(s, v.b[0]);
+	if(v.n == 2)
+		put(s, v.b[1]);
+}
+
+static void
+settle(Sim *sims, char *tab)
+{
+	int i, o;
+	char x[32];
+	for(i = 0; i < 2; i++) {
+		Sim *s = &sims[i];
+		for(o = s->lo; o < s->c; o++)
+			if(s->a[o + 0x100].dirty)
+				say("%s%c[%d] = %s;\n", tab, s->name, o, atom(s->a[o + 0x100], x));
+		if(s->c)
+			say("%su->%cst.ptr += %d;\n", tab, s->name, s->c);
+	}
+}
+
+#pragma mark - Blocks
+
+static void
+mark(int addr)
+{
+	if(addr < TRIM || addr >= p.length || p.leader[addr] || p.nblocks == MAXBLOCKS)
+		return;
+	p.leader[addr] = p.guessing ? 2 : 1;
+	p.blocks[p.nblocks++] = addr;
+}
+
+static void
+target(int lit, Uint8 instr, Uint16 next)
+{
+	if(lit < 0 || p.ram[lit] & 0x1f || (p.ram[lit] & 0x60) != (instr & 0x60))
+		return;
+	mark(instr & 0x20 ? peek16(lit + 1) : (Uint16)(next + (Sint8)p.ram[lit + 1]));
+}
+
+static int
+stops(Uint8 instr, int pc, int len)
+{
+	return len == MAXLEN || pc + size(instr) > p.length || (instr & 0x1f) == 0x16;
+}
+
+static void
+scan(Uint16 addr)
+{
+	int pc = addr, len, prev = -1, prev2 = -1;
+	for(len = 0;; len++) {
+		Uint8 instr = p.ram[pc];
+		if(stops(instr, pc, len)) {
+			mark((instr & 0x1f) == 0x16 ? pc + 1 : pc);
+			return;
+		}
+		switch(instr ? instr & 0x1f : 0x20) {
+		case 0x20: /* BRK */ return;
+		case 0x0c: /* JMP */ target(prev, instr, pc + 1); return;
+		case 0x0d: /* JCN */
+		case 0x0e: /* JSR */ target(prev, instr, pc + 1); mark(pc + 1); return;
+		case 0x17: /* DEO */
+			/* a vector: LIT2 addr LIT port DEO2 */
+			if(instr == 0x37 && prev2 >= 0 && (p.ram[prev2] & 0x7f) == 0x20 && p.ram[prev] == 0x80 && !(p.ram[prev + 1] & 0x0f))
+				mark(peek16(prev2 + 1));
+			mark(pc + 1);
+			return;
+		}
+		prev2 = prev;
+		prev = pc;
+		pc += size(instr);
+	}
+}
+
+static void
+prune(void)
+{
+	int i, t, d, again = 1;
+	while(again) {
+		again = 0;
+		memset(uses, 0, sizeof(uses));
+		for(i = 0, d = 0; i < blen; i++) {
+			if(d < ntemps && i == tdef[d]) {
+				if(dead[d])
+					i = tend[d] - 1;
+				else
+					while(body[i] != '=') i++;
+				d++;
+			} else if(body[i] == 't' && body[i + 1] >= '0' && body[i + 1] <= '9' && !isword(body[i - 1])) {
+				sscanf(body + i + 1, "%d", &t);
+				uses[t]++;
+			}
+		}
+		for(t = 0; t < ntemps; t++)
+			if(!dead[t] && !uses[t])
+				dead[t] = again = 1;
+	}
+	for(i = 0, d = 0, t = 0; i < blen; i++) {
+		if(d < ntemps && i == tdef[d] && dead[d++]) {
+			i = tend[d - 1] - 1;
+			continue;
+		}
+		live[t++] = body[i];
+	}
+	live[t] = '\0';
+}
+
+static int
+refers(char *s, char name)
+{
+	for(; (s = strchr(s + 1, '[')); )
+		if(s[-1] == name && !isword(s[-2]))
+			return 1;
+	return 0;
+}
+
+static void
+declare(FILE *f, int wide)
+{
+	int t, n = 0;
+	for(t = 0; t < ntemps; t++)
+		if(!dead[t] && tshort[t] == wide) {
+			if(!n++)
+				fprintf(f, "\t%s t%d", wide ? "Uint16" : "Uint8", t);
+			else
+				fprintf(f, ", t%d", t);
+		}
+	if(n)
+		fprintf(f, ";\n");
+}
+
+static char *
+symbol(int addr)
+{
+	static char id[48];
+	char *s = NULL;
+	int a, i = sprintf(id, "b_%04x", addr);
+	for(a = addr; a >= TRIM && !(s = p.name[a]); a--)
+		;
+	if(s)
+		for(id[i++] = '_'; *s && i < 46; s++)
+			id[i++] = isword(*s) ? *s : '_';
+	id[i] = '\0';
+	return id;
+}
+
+static int
+span(Uint16 addr)
+{
+	int pc = addr, len;
+	for(len = 0; !stops(p.ram[pc], pc, len); len++) {
+		Uint8 instr = p.ram[pc];
+		pc += size(instr);
+		if(ends(instr))
+			break;
+	}
+	return pc;
+}
+
+static void
+rely(int addr, int n)
+{
+	memset(&p.known[addr], 1, n);
+	if(!guess)
+		memset(&p.fixed[addr], 1, n);
+}
+
+static char *
+watched(char *a, char *buf)
+{
+	/* guessed blocks are checked on entry, but not watched for stores */
+	if(guess)
+		sprintf(buf, "(FIXED(%s) || (Uint16)(%s - 0x%04x) < %d)", a, a, start, end - start);
+	else
+		sprintf(buf, "FIXED(%s)", a);
+	return buf;
+}
+
+static int
+emit(Uint16 pc, Uint8 instr)
+{
+	int n = instr & 0x20 ? 2 : 1, next = (Uint16)(pc + size(instr));
+	Sim *src = &st[instr & 0x40 ? 1 : 0], *dst = &st[instr & 0x40 ? 0 : 1], saved[2];
+	int k = src->c, *c = instr & 0x80 ? &k : &src->c;
+	Val a, b, x;
+	char y[32], z[32], w[256], v[96];
+	say("\t/* %s%s%s%s */\n", instr ? ops[instr & 0x1f] : "BRK", n == 2 ? "2" : "", instr & 0x80 && instr & 0x1f ? "k" : "", instr & 0x40 ? "r" : "");
+	rely(pc, 1);
+	if(!instr) {
+		settle(st, "\t");
+		say("\treturn 0x%04x | HALT;\n", next);
+		return 0;
+	}
+	switch(instr & 0x1f) {
+	/* Stack */
+	case 0x00: /* LIT */
+		if(p.nsyms && !p.name[pc + 1] && (n == 1 || !p.name[pc + 2])) {
+			rely(pc + 1, n);
+			a = konst(n, n == 2 ? peek16(pc + 1) : p.ram[pc + 1]);
+		} else if(n == 2)
+			a = value(2, "m[0x%04x] << 8 | m[0x%04x]", pc + 1, pc + 2);
+		else
+			a = value(1, "m[0x%04x]", pc + 1);
+		push(src, a);
+		break;
+	case 0x01: /* INC */ a = pop(src, c, n); push(src, result(n, "%s + 1", a.s)); break;
+	case 0x02: /* POP */ drop(src, c, n); break;
+	case 0x03: /* DUP */ a = pop(src, c, n); push(src, a); push(src, a); break;
+	case 0x04: /* NIP */ a = pop(src, c, n); drop(src, c, n); push(src, a); break;
+	case 0x05: /* SWP */ a = pop(src, c, n), b = pop(src, c, n); push(src, a); push(src, b); break;
+	case 0x06: /* OVR */ a = pop(src, c, n), b = pop(src, c, n); push(src, b); push(src, a); push(src, b); break;
+	case 0x07: /* ROT */ a = pop(src, c, n), b = pop(src, c, n), x = pop(src, c, n); push(src, b); push(src, a); push(src, x); break;
+	/* Logic */
+	case 0x08: /* EQU */ a = pop(src, c, n), b = pop(src, c, n); push(src, compare("==", 1, b, a)); break;
+	case 0x09: /* NEQ */ a = pop(src, c, n), b = pop(src, c, n); push(src, compare("!=", 0, b, a)); break;
+	case 0x0a: /* GTH */ a = pop(src, c, n), b = pop(src, c, n); push(src, compare(">", 0, b, a)); break;
+	case 0x0b: /* LTH */ a = pop(src, c, n), b = pop(src, c, n); push(src, compare("<", 0, b, a)); break;
+	case 0x0c: /* JMP */
+		a = pop(src, c, n);
+		settle(st, "\t");
+		if(n == 2)
+			say("\treturn %s | TAKEN;\n", a.s);
+		else
+			say("\treturn (Uint16)(0x%04x + (Sint8)%s) | TAKEN;\n", next, a.s);
+		return 0;
+	case 0x0d: /* JCN */
+		a = pop(src, c, n), b = pop(src, c, 1);
+		settle(st, "\t");
+		if(n == 2)
+			say("\tif(%s)\n\t\treturn %s | TAKEN;\n", b.s, a.s);
+		else
+			say("\tif(%s)\n\t\treturn (Uint16)(0x%04x + (Sint8)%s) | TAKEN;\n", b.s, next, a.s);
+		say("\treturn 0x%04x;\n", next);
+		return 0;
+	case 0x0e: /* JSR */
+		a = pop(src, c, n);
+		push(dst, konst(2, next));
+		settle(st, "\t");
+		if(n == 2)
+			say("\treturn %s | TAKEN;\n", a.s);
+		else
+			say("\treturn (Uint16)(0x%04x + (Sint8)%s) | TAKEN;\n", next, a.s);
+		return 0;
+	case 0x0f: /* STH */ a = pop(src, c, n); push(dst, a); break;
+	/* Memory */
+	case 0x10: /* LDZ */
+		a = pop(src, c, 1);
+		push(src, n == 2 ? value(2, "m[%s] << 8 | m[%s + 1]", a.s, a.s) : value(1, "m[%s]", a.s));
+		break;
+	case 0x11: /* STZ */
+		a = pop(src, c, 1), b = pop(src, c, n);
+		if(n == 2)
+			say("\tm[%s] = %s;\n\tm[%s + 1] = %s;\n", a.s, atom(b.b[0], y), a.s, atom(b.b[1], z));
+		else
+			say("\tm[%s] = %s;\n", a.s, b.s);
+		break;
+	case 0x12: /* LDR */
+	case 0x14: /* LDA */
+		if(instr & 0x04)
+			a = pop(src, c, 2);
+		else
+			x = pop(src, c, 1), a = result(2, "0x%04x + (Sint8)%s", next, x.s);
+		push(src, n == 2 ? value(2, "m[%s] << 8 | m[(Uint16)(%s + 1)]", a.s, a.s) : value(1, "m[%s]", a.s));
+		break;
+	case 0x13: /* STR */
+	case 0x15: /* STA */
+		if(instr & 0x04)
+			a = pop(src, c, 2);
+		else
+			x = pop(src, c, 1), a = result(2, "0x%04x + (Sint8)%s", next, x.s);
+		b = pop(src, c, n);
+		sprintf(v, "(Uint16)(%s + 1)", a.s);
+		if(n == 2)
+			say("\tm[%s] = %s;\n\tm[%s] = %s;\n\tif(%s || ", a.s, atom(b.b[0], y), v, atom(b.b[1], z), watched(a.s, w));
+		else
+			say("\tm[%s] = %s;\n\tif(", a.s, b.s);
+		say("%s) {\n", watched(n == 2 ? v : a.s, w));
+		/* translated code was written to, have it checked again */
+		settle(st, "\t\t");
+		say("\t\treturn 0x%04x | WRITE;\n\t}\n", next);
+		break;
+	case 0x17: /* DEO */
+		a = pop(src, c, 1), b = pop(src, c, n);
+		settle(st, "\t");
+		say("\tu->ram.ptr = 0x%04x;\n", next);
+		if(n == 2)
+			say("\tif(!devw8(&u->dev[%s >> 4], %s, %s) || !devw8(&u->dev[%s >> 4], %s + 1, %s))\n", a.s, a.s, atom(b.b[0], y), a.s, a.s, atom(b.b[1], z));
+		else
+			say("\tif(!devw8(&u->dev[%s >> 4], %s, %s))\n", a.s, a.s, b.s);
+		say("\t\treturn 0x%04x | HALT;\n\treturn 0x%04x | WRITE;\n", next, next);
+		return 0;
+	/* Arithmetic */
+	case 0x18: /* ADD */ a = pop(src, c, n), b = pop(src, c, n); push(src, result(n, "%s + %s", b.s, a.s)); break;
+	case 0x19: /* SUB */ a = pop(src, c, n), b = pop(src, c, n); push(src, result(n, "%s - %s", b.s, a.s)); break;
+	case 0x1a: /* MUL */ a = pop(src, c, n), b = pop(src, c, n); push(src, result(n, "(unsigned int)%s * %s", b.s, a.s)); break;
+	case 0x1b: /* DIV */
+		memcpy(saved, st, sizeof(saved));
+		a = pop(src, c, n), b = pop(src, c, n);
+		/* the interpreter reports the division by zero */
+		say("\tif(!%s) {\n", a.s);
+		settle(saved, "\t\t");
+		say("\t\treturn 0x%04x | INTERP;\n\t}\n", pc);
+		push(src, value(n, "%s / %s", b.s, a.s));
+		break;
+	case 0x1c: /* AND */ a = pop(src, c, n), b = pop(src, c, n); push(src, value(n, "%s & %s", b.s, a.s)); break;
+	case 0x1d: /* ORA */ a = pop(src, c, n), b = pop(src, c, n); push(src, value(n, "%s | %s", b.s, a.s)); break;
+	case 0x1e: /* EOR */ a = pop(src, c, n), b = pop(src, c, n); push(src, value(n, "%s ^ %s", b.s, a.s)); break;
+	case 0x1f: /* SFT */ a = pop(src, c, 1), b = pop(src, c, n); push(src, result(n, "%s >> (%s & 0x0f) << ((%s & 0xf0) >> 4)", b.s, a.s, a.s)); break;
+	}
+	return 1;
+}
+
+static void
+guard(FILE *f, Uint16 addr)
+{
+	/* the depths a block reaches are known, only the bounds it can cross are
+	   tested, a block that would fault is left to the interpreter to halt */
+	char *sep = "\tif(";
+	int i;
+	for(i = 0; i < 2; i++) {
+		if(st[i].lo < 0) {
+			fprintf(f, "%su->%cst.ptr < %d", sep, st[i].name, -st[i].lo);
+			sep = " || ";
+		}
+		if(st[i].hi > 0) {
+			fprintf(f, "%su->%cst.ptr > %d", sep, st[i].name, 0xff - st[i].hi);
+			sep = " || ";
+		}
+	}
+	if(*sep == ' ')
+		fprintf(f, ")\n\t\treturn 0x%04x | INTERP;\n", addr);
+}
+
+static int
+translate(FILE *f, Uint16 addr)
+{
+	int i, o, pc = addr, len;
+	blen = ntemps = 0;
+	guess = p.leader[addr] == 2;
+	start = addr;
+	end = span(addr);
+	memset(dead, 0, sizeof(dead));
+	for(i = 0; i < 2; i++) {
+		st[i].name = i ? 'r' : 'w';
+		st[i].c = st[i].lo = st[i].hi = 0;
+		for(o = 0; o < 0x200; o++)
+			st[i].a[o].part = 'm', st[i].a[o].dirty = 0;
+	}
+	for(len = 0;; len++) {
+		Uint8 instr = p.ram[pc];
+		if(stops(instr, pc, len)) {
+			settle(st, "\t");
+			say("\treturn 0x%04x;\n", pc);
+			break;
+		}
+		pc += size(instr);
+		if(!emit(pc - size(instr), instr)) {
+			len++;
+			break;
+		}
+	}
+	if(!len)
+		return 0;
+	prune();
+	if(!p.stores && (p.stores = strstr(live, "FIXED(") != NULL))
+		fprintf(f, "static const Uint8 fixed[0x2000];\n\n");
+	if(!p.devices && (p.devices = strstr(live, "devw8(") != NULL))
+		fprintf(f, "static int devw8(Device *d, Uint8 a, Uint8 b) { d->dat[a & 0xf] = b; return d->talk(d, a & 0x0f, 1); }\n\n");
+	fprintf(f, "static unsigned long\n%s(Uxn *u)\n{\n", symbol(addr));
+	if(refers(live, 'w'))
+		fprintf(f, "\tUint8 *w = &u->wst.dat[u->wst.ptr];\n");
+	if(refers(live, 'r'))
+		fprintf(f, "\tUint8 *r = &u->rst.dat[u->rst.ptr];\n");
+	if(refers(live, 'm'))
+		fprintf(f, "\tUint8 *m = u->ram.dat;\n");
+	declare(f, 0);
+	declare(f, 1);
+	guard(f, addr);
+	fprintf(f, "%s}\n\n", live);
+	return pc - addr;
+}
+
+#pragma mark - Output
+
+static int
+loadsym(char *filename)
+{
+	FILE *f;
+	char path[0x400];
+	int c, addr, used = 0;
+	if(strlen(filename) > sizeof(path) - 5 || !(f = fopen(strcat(strcpy(path, filename), ".sym"), "rb")))
+		return 0;
+	while((addr = fgetc(f)) != EOF && (c = fgetc(f)) != EOF) {
+		char *name = &p.pool[used];
+		addr = addr << 8 | c;
+		while((c = fgetc(f)) != EOF && c && used < (int)sizeof(p.pool) - 1)
+			p.pool[used++] = c;
+		p.pool[used++] = '\0';
+		if(!p.name[addr])
+			p.name[addr] = name;
+		p.nsyms++;
+	}
+	fclose(f);
+	return 1;
+}
+
+static void
+table(FILE *f, char *decl, Uint8 *bytes, int len)
+{
+	int i;
+	fprintf(f, "%s = {", decl);
+	for(i = 0; i < len; i++)
+		fprintf(f, "%s0x%02x,", i % 16 ? " " : "\n\t", bytes[i]);
+	fprintf(f, "\n};\n\n");
+}
+
+static void
+translateall(FILE *f, char *filename)
+{
+	static Uint16 entry[0x10000];
+	static Uint8 known[0x2000], fixed[0x2000];
+	static int addrs[MAXBLOCKS], lens[MAXBLOCKS];
+	int i, n = 0, length = p.length - TRIM;
+	char *lines[] = {
+		"#include <stdlib.h>",
+		"#include <string.h>",
+		"#include <pthread.h>",
+		"#include \"uxn.h\"",
+		"",
+		"/*",
+		" ^",
+		"/!\\ THIS FILE IS AUTOMATICALLY GENERATED",
+		"---",
+		"",
+		"Translated from a rom by src/uxn2c.c, to be built in place of src/uxn-jit.c.",
+		"",
+		"*/",
+		"",
+		"#define TAKEN 0x10000",
+		"#define WRITE 0x20000",
+		"#define INTERP 0x40000",
+		"#define HALT 0x80000",
+		"#define KNOWN(a) (known[(a) >> 3] >> ((a)&7) & 1)",
+		"#define FIXED(a) (fixed[(a) >> 3] >> ((a)&7) & 1)",
+		"",
+		"typedef struct {",
+		"	Uint16 addr, len, whole, guess;",
+		"	unsigned long (*run)(Uxn *u);",
+		"} Block;",
+		"",
+		"typedef struct Aot {",
+		"	Uxn *u;",
+		"	struct Aot *next;",
+		"	Uint8 last;",
+		"	unsigned long epoch, seen[BLOCKS];",
+		"} Aot;",
+		"",
+		"static const Uint8 known[0x2000];",
+		"static Aot *aots;",
+		"static pthread_mutex_t aotslock = PTHREAD_MUTEX_INITIALIZER;",
+		"",
+		NULL};
+	for(i = 0; i < p.nblocks; i++)
+		scan(p.blocks[i]);
+	/* code only reached by computed jumps, or data, going by the labels */
+	for(p.guessing = 1, i = TRIM; i < p.length; i++)
+		if(p.name[i])
+			mark(i);
+	for(i = 0; i < p.nblocks; i++)
+		if(p.leader[p.blocks[i]] == 2)
+			scan(p.blocks[i]);
+	fprintf(f, "/* %s */\n\n#define TRIM 0x%04x\n#define LENGTH 0x%04x\n#define BLOCKS %d\n\n", filename, TRIM, length, p.nblocks + 1);
+	for(i = 0; lines[i]; i++)
+		fprintf(f, "%s\n", lines[i]);
+	for(i = TRIM; i < p.length; i++)
+		if(p.leader[i] && (lens[n] = translate(f, i)))
+			entry[i - TRIM] = n + 1, addrs[n++] = i;
+	for(i = 0; i < 0x10000; i++) {
+		known[i >> 3] |= p.known[i] << (i & 7);
+		fixed[i >> 3] |= p.fixed[i] << (i & 7);
+	}
+	table(f, "static const Uint8 rom[LENGTH]", p.ram + TRIM, length);
+	table(f, "static const Uint8 known[0x2000]", known, sizeof(known));
+	if(p.stores)
+		table(f, "static const Uint8 fixed[0x2000]", fixed, sizeof(fixed));
+	fprintf(f, "static const Block blocks[BLOCKS] = {\n");
+	for(i = 0; i < n; i++)
+		fprintf(f, "\t{0x%04x, %d, %d, %d, %s},\n", addrs[i], lens[i], !memchr(&p.known[addrs[i]], 0, lens[i]), p.leader[addrs[i]] == 2, symbol(addrs[i]));
+	fprintf(f, "};\n\nstatic const Uint16 entry[LENGTH] = {");
+	for(i = 0; i < length; i++)
+		fprintf(f, "%s%d,", i % 16 ? " " : "\n\t", entry[i]);
+	fprintf(f, "\n};\n\n");
+	for(i = 0; runtime[i]; i++)
+		fprintf(f, "%s\n", runtime[i]);
+	fprintf(stderr, "Translated %s, %d blocks, %d symbols.\n", filename, n, p.nsyms);
+}
+
+int
+main(int argc, char *argv[])
+{
+	FILE *f;
+	if(argc < 3)
+		return !error("usage", "input.rom output.c");
+	if(!(f = fopen(argv[1], "rb")))
+		return !error("Load", "Failed to open rom.");
+	p.length = TRIM + fread(p.ram + TRIM, 1, 0x10000 - TRIM, f);
+	fclose(f);
+	loadsym(argv[1]);
+	mark(TRIM);
+	if(!(f = fopen(argv[2], "w")))
+		return !error("Save", "Failed to open output.");
+	translateall(f, argv[1]);
+	fclose(f);
+	return 0;
+}
@@ -1,4 +1,20 @@
+#define _DEFAULT_SOURCE
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32) && !defined(__plan9__)
+#define POSIX
+#include <unistd.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#ifdef __APPLE__
+#define st_mtim st_mtimespec
+#endif
+#endif
+#include "uxnasm.h"
 
 /*
 Copyright (c) 2021 Devine Lu Linvega
@@ -19,24 +35,70 @@ typedef signed char Sint8;
 typedef unsigned short Uint16;
 
 typedef struct {
-	char name[64], items[64][64];
-	Uint8 len;
+	char *name, **items;
+	int len;
 } Macro;
 
 typedef struct {
-	char name[64];
+	char *name;
 	Uint16 addr, refs;
+	int bytes, cycles; /* saved by the optimizer */
+	int dropped; /* unreachable, left out of the rom */
+	int size, ops; /* emitted up to the next label */
 } Label;
 
 typedef struct {
-	Uint8 data[LENGTH], mlen;
-	Uint16 ptr, length, llen;
-	Label labels[512];
-	Macro macros[256];
+	char *name, rune; /* rune is 0 once resolved */
+	Uint16 addr; /* of the first byte of the reference */
+	int next; /* older fixup + 1 to the same name, or 0 */
+} Fixup;
+
+typedef struct {
+	char *str;
+	Uint16 addr, len;
+} Line;
+
+typedef struct Source Source;
+
+typedef struct {
+	char *str, rune; /* rune is the leading symbol, or 0 for words */
+	int len;
+	Source *inc; /* included source, the token is its path */
+} Token;
+
+struct Source {
+	char *path, *src, *tail; /* tail holds a token that ends the file */
+	int size, len, pos, ilen, *includes;
+	long stamp[5]; /* what the file looked like when it was read */
+	Token *tokens;
+	Source *next; /* in the cache */
+};
+
+typedef struct {
+	int single, optimizing, shaking, map, listing, jobs, elen;
+	char *exports[0x40];
+} Options;
+
+typedef struct {
+	int cap, *index; /* entry + 1 by name hash, 0 when empty */
+} Table;
+
+typedef struct {
+	Uint8 data[LENGTH];
+	Uint16 ptr, length;
+	int llen, mlen, slen, flen, bytes, cycles;
+	int mapping, listing, lnlen, routine, part; /* label + 1 taking the bytes emitted */
+	Label *labels;
+	Macro *macros;
+	char **strings;
+	Fixup *fixups;
+	Table ltab, mtab, stab, ftab;
 } Program;
 
-Program p;
+static Program p;
 static Uint16 addr = 0;
+static Line *lines;
+static int lncap;
 
 /* clang-format off */
 
@@ -48,6 +110,7 @@ static char ops[][4] = {
 };
 
 static int   cpos(char *s, char a){ int i = 0; char c; while((c = s[i++])) if(c == a) return i; return -1; }
+static int   sequ(char *a, char *b) { while(*a && *a == *b) a++, b++; return *a == *b; } /* string equal */
 static int   scmp(char *a, char *b, int len) { int i = 0; while(a[i] == b[i]) if(!a[i] || ++i >= len) return 1; return 0; } /* string compare */
 static int   sihx(char *s) { int i = 0; char c; while((c = s[i++])) if(!(c >= '0' && c <= '9') && !(c >= 'a' && c <= 'f')) return 0; return i > 1; } /* string is hexadecimal */
 static int   shex(char *s) { int n = 0, i = 0; char c; while((c = s[i++])) if(c >= '0' && c <= '9') n = n * 16 + (c - '0'); else if(c >= 'a' && c <= 'f') n = n * 16 + 10 + (c - 'a'); return n; } /* string to num */
@@ -59,26 +122,172 @@ static char *scat(char *dst, const char *src) { char *ptr = dst + slen(dst); whi
 
 /* clang-format on */
 
+#pragma mark - Memory
+
+static char *arena; /* chained to the previous block through its first word */
+static int used, avail;
+
+static void *
+check(void *ptr)
+{
+	if(!ptr) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	return ptr;
+}
+
+static void *
+alloc(int size)
+{
+	void *ptr;
+	size = (size + 7) & ~7;
+	if(size > avail) {
+		char *block;
+		avail = size + 8 > 0x10000 ? size + 8 : 0x10000;
+		block = check(calloc(avail, 1));
+		*(char **)block = arena;
+		arena = block;
+		used = 8, avail -= 8;
+	}
+	ptr = arena + used;
+	used += size, avail -= size;
+	return ptr;
+}
+
+static void
+reset(void)
+{
+	while(arena) {
+		char *prev = *(char **)arena;
+		free(arena);
+		arena = prev;
+	}
+	used = avail = 0;
+	memset(&p, 0, sizeof(p));
+	addr = 0;
+}
+
+static void *
+reserve(void *buf, int *cap, int len)
+{
+	if(len <= *cap)
+		return buf;
+	while(*cap < len)
+		*cap = *cap ? *cap * 2 : 64;
+	return check(realloc(buf, *cap));
+}
+
+#pragma mark - Tables
+
+static unsigned int
+hash(char *s)
+{
+	unsigned int h = 5381;
+	while(*s)
+		h = h * 33 + (Uint8)*s++;
+	return h;
+}
+
+/* Entries start with their name, are size bytes apart, and the index is twice as large. */
+
+static int *
+slot(Table *t, void *entries, int size, char *name)
+{
+	unsigned int mask = t->cap - 1, i = hash(name) & mask;
+	int *e;
+	while(*(e = &t->index[i]) && !sequ(*(char **)((char *)entries + (*e - 1) * size), name))
+		i = (i + 1) & mask;
+	return e;
+}
+
+static void *
+grow(Table *t, void *entries, int len, int size)
+{
+	int i;
+	void *prev = entries;
+	if((len + 1) * 2 <= t->cap)
+		return entries;
+	t->cap = t->cap ? t->cap * 2 : 256;
+	t->index = alloc(t->cap * sizeof(int));
+	entries = alloc(t->cap / 2 * size);
+	if(len)
+		memcpy(entries, prev, len * size);
+	for(i = 0; i < len; ++i)
+		*slot(t, entries, size, *(char **)((char *)entries + i * size)) = i + 1;
+	return entries;
+}
+
+static char *
+intern(char *s)
+{
+	int *e;
+	p.strings = grow(&p.stab, p.strings, p.slen, sizeof(char *));
+	if(!*(e = slot(&p.stab, p.strings, sizeof(char *), s))) {
+		p.strings[p.slen++] = strcpy(alloc(slen(s) + 1), s);
+		*e = p.slen;
+	}
+	return p.strings[*e - 1];
+}
+
 #pragma mark - I/O
 
+/* The tokenizer writes into the text, so a source is read into its own
+   buffer rather than mapped from a file that may change under it. */
+
+static int
+load(Source *s)
+{
+	FILE *f;
+	if(!(f = fopen(s->path, "rb")))
+		return 0;
+	fseek(f, 0, SEEK_END);
+	s->size = ftell(f);
+	rewind(f);
+	s->src = check(malloc(s->size + 1));
+	s->size = fread(s->src, 1, s->size, f);
+	fclose(f);
+	return 1;
+}
+
+static void
+unload(Source *s)
+{
+	free(s->src), free(s->tail), free(s->tokens), free(s->includes);
+	s->src = s->tail = NULL, s->tokens = NULL, s->includes = NULL;
+	s->len = s->ilen = 0;
+}
+
+static Token *
+next(Source *s)
+{
+	return s->pos < s->len ? &s->tokens[s->pos++] : NULL;
+}
+
+static char
+runeof(char *w)
+{
+	return cpos("|$@&%([{}])#.,;:'\"", w[0]) != -1 ? w[0] : 0;
+}
+
 static Macro *
 findmacro(char *name)
 {
-	int i;
-	for(i = 0; i < p.mlen; ++i)
-		if(scmp(p.macros[i].name, name, 64))
-			return &p.macros[i];
-	return NULL;
+	int *e;
+	if(!p.mlen)
+		return NULL;
+	e = slot(&p.mtab, p.macros, sizeof(Macro), name);
+	return *e ? &p.macros[*e - 1] : NULL;
 }
 
 static Label *
 findlabel(char *name)
 {
-	int i;
-	for(i = 0; i < p.llen; ++i)
-		if(scmp(p.labels[i].name, name, 64))
-			return &p.labels[i];
-	return NULL;
+	int *e;
+	if(!p.llen)
+		return NULL;
+	e = slot(&p.ltab, p.labels, sizeof(Label), name);
+	return *e ? &p.labels[*e - 1] : NULL;
 }
 
 static Uint8
@@ -131,40 +340,139 @@ pushword(char *s)
 }
 
 static char *
-sublabel(char *src, char *scope, char *name)
+sublabel(char rune, char *scope, char *name)
 {
-	return scat(scat(scpy(scope, src, 64), "/"), name);
+	static char *buf;
+	static int cap;
+	buf = reserve(buf, &cap, slen(scope) + slen(name) + 3);
+	buf[0] = rune, buf[1] = '\0';
+	return scat(scat(scat(buf, scope), "/"), name);
 }
 
 #pragma mark - Parser
 
+static Assembly *diag; /* collects the errors while in uxnasm() */
+
 static int
-error(char *name, char *msg)
+report(int warning, char *name, char *msg)
 {
-	fprintf(stderr, "%s: %s\n", name, msg);
+	Diagnostic *d;
+	if(!diag)
+		fprintf(stderr, "%s: %s\n", name, msg);
+	else if(diag->len < (int)(sizeof(diag->list) / sizeof(diag->list[0]))) {
+		d = &diag->list[diag->len++];
+		d->warning = warning;
+		scpy(name, d->name, sizeof(d->name));
+		scpy(msg, d->msg, sizeof(d->msg));
+	}
 	return 0;
 }
 
 static int
-makemacro(char *name, FILE *f)
+error(char *name, char *msg)
 {
+	return report(0, name, msg);
+}
+
+static int
+makemacro(char *name, Source *s)
+{
+	static char **items;
+	static int cap;
 	Macro *m;
-	char word[64];
+	Token *t;
 	if(findmacro(name))
 		return error("Macro duplicate", name);
 	if(sihx(name) && slen(name) % 2 == 0)
 		return error("Macro name is hex number", name);
 	if(findopcode(name) || scmp(name, "BRK", 4) || !slen(name) || scmp(name, "include", 8))
 		return error("Macro name is invalid", name);
+	p.macros = grow(&p.mtab, p.macros, p.mlen, sizeof(Macro));
 	m = &p.macros[p.mlen++];
-	scpy(name, m->name, 64);
-	while(fscanf(f, "%63s", word) == 1) {
-		if(word[0] == '{') continue;
-		if(word[0] == '}') break;
-		if(m->len > 64)
-			return error("Macro too large", name);
-		scpy(word, m->items[m->len++], 64);
+	m->name = intern(name);
+	*slot(&p.mtab, p.macros, sizeof(Macro), m->name) = p.mlen;
+	while((t = next(s))) {
+		if(t->rune == '{') continue;
+		if(t->rune == '}') break;
+		items = reserve(items, &cap, (m->len + 1) * sizeof(char *));
+		items[m->len++] = intern(t->str);
+	}
+	m->items = memcpy(alloc(m->len * sizeof(char *)), items, m->len * sizeof(char *));
+	return 1;
+}
+
+static int
+addref(Label *l, Uint8 rel)
+{
+	if(rel) {
+		int pos = cpos(l->name, '/');
+		if(pos != -1) {
+			static char *root;
+			static int cap;
+			Label *rl;
+			root = reserve(root, &cap, pos);
+			rl = findlabel(scpy(l->name, root, pos));
+			++rl->refs;
+		}
+	}
+	return ++l->refs;
+}
+
+static int
+isref(char *w)
+{
+	return w[0] == '.' || w[0] == ',' || w[0] == ':' || w[0] == ';';
+}
+
+static int
+resolve(char rune, Uint16 at, Label *l)
+{
+	switch(rune) {
+	case '.': /* zero-page: LIT addr-lb */
+		if(l->addr > 0xff)
+			return error("Address is not in zero page", l->name);
+		p.data[(Uint16)(at + 1)] = l->addr;
+		return addref(l, 1);
+	case ',': { /* relative: LIT addr-rel */
+		int off = l->addr - at - 3;
+		if(off < -126 || off > 126)
+			return error("Address is too far", l->name);
+		p.data[(Uint16)(at + 1)] = (Sint8)off;
+		return addref(l, 0);
 	}
+	case ':': /* raw: addr-hb addr-lb */
+		p.data[at] = l->addr >> 8;
+		p.data[(Uint16)(at + 1)] = l->addr & 0xff;
+		return addref(l, 1);
+	default: /* absolute: LIT addr-hb addr-lb */
+		p.data[(Uint16)(at + 1)] = l->addr >> 8;
+		p.data[(Uint16)(at + 2)] = l->addr & 0xff;
+		return addref(l, 1);
+	}
+}
+
+/* Emits a reference, patched now when the label is known, or once it is defined. */
+
+static int
+makeref(char rune, char *name, Label *l)
+{
+	Uint16 at = p.ptr;
+	Fixup *f;
+	int *e;
+	if(rune == ':' || rune == ';')
+		pushshort(0, rune == ';');
+	else
+		pushbyte(0, 1);
+	if(l)
+		return resolve(rune, at, l);
+	p.fixups = grow(&p.ftab, p.fixups, p.flen, sizeof(Fixup));
+	f = &p.fixups[p.flen++];
+	f->name = intern(name);
+	f->rune = rune;
+	f->addr = at;
+	e = slot(&p.ftab, p.fixups, sizeof(Fixup), f->name);
+	f->next = *e;
+	*e = p.flen;
 	return 1;
 }
 
@@ -178,25 +486,21 @@ makelabel(char *name)
 		return error("Label name is hex number", name);
 	if(findopcode(name) || scmp(name, "BRK", 4) || !slen(name))
 		return error("Label name is invalid", name);
+	p.labels = grow(&p.ltab, p.labels, p.llen, sizeof(Label));
 	l = &p.labels[p.llen++];
+	l->name = intern(name);
 	l->addr = addr;
-	l->refs = 0;
-	scpy(name, l->name, 64);
-	return 1;
-}
-
-static int
-addref(Label *l, Uint8 rel)
-{
-	if(rel) {
-		int pos = cpos(l->name, '/');
-		if(pos != -1) {
-			char root[64];
-			Label *rl = findlabel(scpy(l->name, root, pos));
-			++rl->refs;
+	*slot(&p.ltab, p.labels, sizeof(Label), l->name) = p.llen;
+	if(p.flen) {
+		int i = *slot(&p.ftab, p.fixups, sizeof(Fixup), l->name);
+		for(; i; i = p.fixups[i - 1].next) {
+			Fixup *f = &p.fixups[i - 1];
+			if(!resolve(f->rune, f->addr, l))
+				return 0;
+			f->rune = 0;
 		}
 	}
-	return ++l->refs;
+	return 1;
 }
 
 static int
@@ -242,28 +546,53 @@ walktoken(char *w)
 	return error("Invalid token", w);
 }
 
+static int
+opcount(char *w)
+{
+	Macro *m;
+	int i, res = 0;
+	if(findopcode(w) || scmp(w, "BRK", 4) || cpos("#.,;", w[0]) != -1)
+		return 1;
+	if(cpos("[]'$\":", w[0]) == -1 && (m = findmacro(w)))
+		for(i = 0; i < m->len; ++i)
+			res += opcount(m->items[i]);
+	return res;
+}
+
+/* Gives the bytes emitted since at to the current labels, and lists them. */
+
+static void
+note(Token *t, char *scope, Uint16 at)
+{
+	int i, len = (Uint16)(p.ptr - at), count = 0;
+	if(!p.mapping && !p.listing)
+		return;
+	if(t->rune == '@' || t->rune == '&') {
+		Label *l = findlabel(t->rune == '@' ? t->str + 1 : sublabel('\0', scope, t->str + 1));
+		if(l && t->rune == '@')
+			p.routine = l - p.labels + 1;
+		if(l)
+			p.part = l - p.labels + 1;
+	} else if(t->rune != '$')
+		count = opcount(t->str);
+	for(i = 0; i < 2; ++i)
+		if(i ? p.part && p.part != p.routine : p.routine) {
+			Label *l = &p.labels[(i ? p.part : p.routine) - 1];
+			l->size += len, l->ops += count;
+		}
+	if(p.listing) {
+		lines = reserve(lines, &lncap, (p.lnlen + 1) * sizeof(Line));
+		lines[p.lnlen].str = t->str, lines[p.lnlen].addr = at, lines[p.lnlen++].len = len;
+	}
+}
+
 static int
 parsetoken(char *w)
 {
 	Label *l;
 	Macro *m;
-	if(w[0] == '.' && (l = findlabel(w + 1))) { /* zero-page */
-		if(l->addr > 0xff)
-			return error("Address is not in zero page", w);
-		pushbyte(l->addr, 1);
-		return addref(l, 1);
-	} else if(w[0] == ',' && (l = findlabel(w + 1))) { /* relative */
-		int off = l->addr - p.ptr - 3;
-		if(off < -126 || off > 126)
-			return error("Address is too far", w);
-		pushbyte((Sint8)off, 1);
-		return addref(l, 0);
-	} else if(w[0] == ':' && (l = findlabel(w + 1))) { /* raw */
-		pushshort(l->addr, 0);
-		return addref(l, 1);
-	} else if(w[0] == ';' && (l = findlabel(w + 1))) { /* absolute */
-		pushshort(l->addr, 1);
-		return addref(l, 1);
+	if(isref(w) && (l = findlabel(w + 1))) { /* label */
+		return makeref(w[0], w + 1, l);
 	} else if(findopcode(w) || scmp(w, "BRK", 4)) { /* opcode */
 		pushbyte(findopcode(w), 0);
 		return 1;
@@ -297,96 +626,535 @@ parsetoken(char *w)
 			if(!parsetoken(m->items[i]))
 				return error("Invalid macro", m->name);
 		return 1;
+	} else if(isref(w) && w[1]) { /* label yet to be defined */
+		return makeref(w[0], w + 1, NULL);
 	}
 	return error("Invalid token", w);
 }
 
+/* Splits a source in place, drops comments and notes includes outside of macros. */
+
 static int
-doinclude(FILE *f, int (*pass)(FILE *))
+tokenize(Source *s)
 {
-	char word[64];
-	FILE *finc;
-	int ret;
-	if(fscanf(f, "%63s", word) != 1)
+	char *src = s->src;
+	int i = 0, size = s->size, cap = 0, icap = 0, ccmnt = 0, cmacr = 0, include = 0;
+	while(1) {
+		Token *t;
+		int start;
+		while(i < size && (Uint8)src[i] <= ' ') i++;
+		if(i == size) break;
+		for(start = i; i < size && (Uint8)src[i] > ' '; i++)
+			;
+		if(!include && !cmacr && skipblock(src + start, &ccmnt, '(', ')'))
+			continue;
+		s->tokens = reserve(s->tokens, &cap, (s->len + 1) * sizeof(Token));
+		t = &s->tokens[s->len++];
+		t->len = i - start;
+		if(i < size)
+			(t->str = src + start)[t->len] = '\0', i++;
+		else
+			t->str = s->tail = memcpy(check(calloc(t->len + 1, 1)), src + start, t->len);
+		t->rune = runeof(t->str);
+		t->inc = NULL;
+		if(include) {
+			s->includes = reserve(s->includes, &icap, (s->ilen + 1) * sizeof(int));
+			s->includes[s->ilen++] = s->len - 1;
+			include = 0;
+		} else if(cmacr) {
+			if(t->rune == '}') cmacr = 0;
+		} else if(t->rune == '%')
+			cmacr = 1;
+		else if(scmp(t->str, "include", 8))
+			include = 1, s->len--;
+	}
+	if(include)
 		return error("End of input", "include");
-	if(!(finc = fopen(word, "r")))
-		return error("Include failed to open", word);
-	ret = pass(finc);
-	fclose(finc);
-	return ret;
+	return 1;
+}
+
+/* Sources are kept between assemblies, and read again once their file changes. */
+
+static Source *sources;
+static char *cwd;
+
+static int attach(Source *s, int depth);
+
+static Source *
+source(char *path, int depth)
+{
+	static char *key;
+	static int cap;
+	Source *s;
+	long stamp[5] = {0};
+#ifdef POSIX
+	struct stat st;
+	if(stat(path, &st)) {
+		error(depth ? "Include failed to open" : "Load failed to open", path);
+		return NULL;
+	}
+	/* an edit within the same second that keeps the size still moves the
+	   nanoseconds and the ctime, a file replaced by rename gets a new inode */
+	stamp[0] = st.st_mtime, stamp[1] = st.st_mtim.tv_nsec, stamp[2] = st.st_ctime;
+	stamp[3] = st.st_ino, stamp[4] = st.st_size;
+#else
+	stamp[0] = -1; /* nothing to tell a changed file by, read it again */
+#endif
+	if(depth > 0x40) {
+		error("Recursion level too deep", path);
+		return NULL;
+	}
+	key = reserve(key, &cap, (cwd ? slen(cwd) : 0) + slen(path) + 2);
+	key[0] = '\0';
+	if(cwd && path[0] != '/')
+		scat(scat(key, cwd), "/");
+	scat(key, path);
+	for(s = sources; s; s = s->next)
+		if(sequ(s->path, key))
+			break;
+	if(!s) {
+		s = check(calloc(1, sizeof(Source)));
+		s->path = strcpy(check(malloc(slen(key) + 1)), key);
+		s->next = sources;
+		sources = s;
+	} else if(s->src && (stamp[0] == -1 || memcmp(s->stamp, stamp, sizeof(stamp))))
+		unload(s);
+	if(!s->src) {
+		if(!load(s)) {
+			error(depth ? "Include failed to open" : "Load failed to open", path);
+			return NULL;
+		}
+		memcpy(s->stamp, stamp, sizeof(stamp));
+		if(!tokenize(s)) {
+			unload(s);
+			return NULL;
+		}
+	}
+	return attach(s, depth) ? s : NULL;
 }
 
 static int
-pass1(FILE *f)
+attach(Source *s, int depth)
 {
-	int ccmnt = 0;
-	char w[64], scope[64], subw[64];
-	while(fscanf(f, "%63s", w) == 1) {
-		if(skipblock(w, &ccmnt, '(', ')')) continue;
-		if(slen(w) >= 63)
-			return error("Pass 1 - Invalid token", w);
-		if(w[0] == '|') {
+	int i;
+	for(i = 0; i < s->ilen; ++i) {
+		Token *t = &s->tokens[s->includes[i]];
+		if(!(t->inc = source(t->str, depth + 1)))
+			return 0;
+	}
+	return 1;
+}
+
+static int
+pass1(Source *s)
+{
+	char *w, *scope = "";
+	Token *t;
+	s->pos = 0;
+	while((t = next(s))) {
+		w = t->str;
+		if(t->inc) {
+			if(!pass1(t->inc))
+				return 0;
+			continue;
+		}
+		if(t->rune == '|') {
 			if(!sihx(w + 1))
 				return error("Pass 1 - Invalid padding", w);
 			addr = shex(w + 1);
-		} else if(w[0] == '%') {
-			if(!makemacro(w + 1, f))
+		} else if(t->rune == '%') {
+			if(!makemacro(w + 1, s))
 				return error("Pass 1 - Invalid macro", w);
-		} else if(w[0] == '@') {
+		} else if(t->rune == '@') {
 			if(!makelabel(w + 1))
 				return error("Pass 1 - Invalid label", w);
-			scpy(w + 1, scope, 64);
-		} else if(w[0] == '&') {
-			if(!makelabel(sublabel(subw, scope, w + 1)))
+			scope = intern(w + 1);
+		} else if(t->rune == '&') {
+			if(!makelabel(sublabel('\0', scope, w + 1)))
 				return error("Pass 1 - Invalid sublabel", w);
-		} else if(scmp(w, "include", 8)) {
-			if(!doinclude(f, pass1))
-				return 0;
 		} else if(sihx(w))
-			addr += slen(w) / 2;
+			addr += t->len / 2;
 		else
 			addr += walktoken(w);
 	}
-	rewind(f);
 	return 1;
 }
 
 static int
-pass2(FILE *f)
+pass2(Source *s)
 {
-	int ccmnt = 0, cmacr = 0;
-	char w[64], scope[64], subw[64];
-	while(fscanf(f, "%63s", w) == 1) {
-		if(w[0] == '%') continue;
-		if(w[0] == '&') continue;
-		if(w[0] == '[') continue;
-		if(w[0] == ']') continue;
-		if(skipblock(w, &ccmnt, '(', ')')) continue;
+	int cmacr = 0;
+	Uint16 at;
+	char *w, *scope = "";
+	Token *t;
+	s->pos = 0;
+	while((t = next(s))) {
+		w = t->str;
+		if(t->inc) {
+			if(!pass2(t->inc))
+				return 0;
+			continue;
+		}
+		if(t->rune == '%') continue;
+		if(t->rune == '[') continue;
+		if(t->rune == ']') continue;
 		if(skipblock(w, &cmacr, '{', '}')) continue;
-		if(w[0] == '|') {
+		at = p.ptr;
+		if(t->rune == '|') {
 			if(p.length && shex(w + 1) < p.ptr)
 				return error("Pass 2 - Memory overwrite", w);
 			p.ptr = shex(w + 1);
 			continue;
-		} else if(w[0] == '$') {
+		} else if(t->rune == '$') {
 			p.ptr += shex(w + 1);
+			note(t, scope, at);
 			continue;
-		} else if(w[0] == '@') {
-			scpy(w + 1, scope, 64);
+		} else if(t->rune == '@') {
+			scope = intern(w + 1);
+			note(t, scope, at);
 			continue;
-		} else if(scmp(w, "include", 8)) {
-			if(!doinclude(f, pass2))
-				return 0;
+		} else if(t->rune == '&') {
+			note(t, scope, at);
 			continue;
 		}
-		if(w[1] == '&' && (w[0] == '.' || w[0] == ',' || w[0] == ';' || w[0] == ':'))
-			scpy(sublabel(subw, scope, w + 2), w + 1, 64);
+		if(w[1] == '&' && isref(w))
+			w = sublabel(w[0], scope, w + 2);
 		if(!parsetoken(w))
 			return error("Pass 2 - Unknown label", w);
+		note(t, scope, at);
+	}
+	return 1;
+}
+
+/* Emits as it goes, references to labels defined further are patched once they are. */
+
+static int
+assemble(Source *s)
+{
+	int cmacr = 0;
+	Uint16 at;
+	char *w, *scope = "";
+	Token *t;
+	s->pos = 0;
+	while((t = next(s))) {
+		w = t->str;
+		if(t->inc) {
+			if(!assemble(t->inc))
+				return 0;
+			continue;
+		}
+		if(t->rune == '[') continue;
+		if(t->rune == ']') continue;
+		if(skipblock(w, &cmacr, '{', '}')) continue;
+		at = p.ptr;
+		if(t->rune == '|') {
+			if(!sihx(w + 1))
+				return error("Invalid padding", w);
+			if(p.length && shex(w + 1) < p.ptr)
+				return error("Memory overwrite", w);
+			p.ptr = shex(w + 1);
+		} else if(t->rune == '$') {
+			p.ptr += shex(w + 1);
+			note(t, scope, at);
+		} else if(t->rune == '%') {
+			if(!makemacro(w + 1, s))
+				return error("Invalid macro", w);
+		} else if(t->rune == '@') {
+			addr = p.ptr;
+			if(!makelabel(w + 1))
+				return error("Invalid label", w);
+			scope = intern(w + 1);
+			note(t, scope, at);
+		} else if(t->rune == '&') {
+			addr = p.ptr;
+			if(!makelabel(sublabel('\0', scope, w + 1)))
+				return error("Invalid sublabel", w);
+			note(t, scope, at);
+		} else {
+			if(w[1] == '&' && isref(w))
+				w = sublabel(w[0], scope, w + 2);
+			if(!parsetoken(w))
+				return 0;
+			note(t, scope, at);
+		}
 	}
 	return 1;
 }
 
+static int
+resolved(void)
+{
+	int i, ok = 1;
+	for(i = 0; i < p.flen; ++i)
+		if(p.fixups[i].rune)
+			ok = error("Unknown label", p.fixups[i].name);
+	return ok;
+}
+
+#pragma mark - Optimizer
+
+static char *pairs[][3] = {
+	{"#01", "ADD", "INC"}, {"#0001", "ADD2", "INC2"},
+	{"DUP", "POP", ""}, {"DUP2", "POP2", ""},
+	{"SWP", "SWP", ""}, {"SWP2", "SWP2", ""},
+	{"JSR", "JMP2r", "JMP"}, {"JSR2", "JMP2r", "JMP2"}};
+
+static void
+settoken(Token *t, char *w)
+{
+	t->str = w, t->len = slen(w), t->rune = runeof(w), t->inc = NULL;
+}
+
+static void
+expand(Source *s, int *cap, char *w)
+{
+	Macro *m;
+	int i;
+	if(!findopcode(w) && !sihx(w) && !(isref(w) && findlabel(w + 1)) && (m = findmacro(w)))
+		for(i = 0; i < m->len; ++i)
+			expand(s, cap, m->items[i]);
+	else {
+		s->tokens = reserve(s->tokens, cap, (s->len + 1) * sizeof(Token));
+		settoken(&s->tokens[s->len++], w);
+	}
+}
+
+/* Inlines includes and macros, the macros are already defined by pass 1. */
+
+static void
+flatten(Source *dst, int *cap, Source *src)
+{
+	int i;
+	for(i = 0; i < src->len; ++i) {
+		Token *t = &src->tokens[i];
+		if(t->inc)
+			flatten(dst, cap, t->inc);
+		else if(t->rune == '%')
+			while(++i < src->len && src->tokens[i].rune != '}')
+				;
+		else
+			expand(dst, cap, t->str);
+	}
+}
+
+static void
+save(Label *l, int bytes, int cycles)
+{
+	if(l)
+		l->bytes += bytes, l->cycles += cycles;
+	p.bytes += bytes, p.cycles += cycles;
+}
+
+static int
+peephole(Source *s)
+{
+	Label *scope = NULL;
+	int i = 0, j, o = 0, n = s->len, changes = 0;
+	while(i < n) {
+		Token *t = s->tokens + i;
+		int byte = t->rune == '#' && t->len == 3 && sihx(t->str + 1), left = n - i;
+		if(t->rune == '@')
+			scope = findlabel(t->str + 1);
+		for(j = 0; left > 1 && j < (int)(sizeof(pairs) / sizeof(pairs[0])); ++j)
+			if(sequ(t->str, pairs[j][0]) && sequ(t[1].str, pairs[j][1]))
+				break;
+		if(left > 1 && j < (int)(sizeof(pairs) / sizeof(pairs[0]))) {
+			save(scope, walktoken(pairs[j][0]) + 1 - !!pairs[j][2][0], 2 - !!pairs[j][2][0]);
+			if(pairs[j][2][0])
+				settoken(&s->tokens[o++], pairs[j][2]);
+			i += 2;
+		} else if(left > 1 && ((byte && sequ(t[1].str, "POP")) || (t->rune == '#' && t->len == 5 && sihx(t->str + 1) && sequ(t[1].str, "POP2")))) {
+			save(scope, t->len == 3 ? 3 : 4, 2); /* literal dropped right away */
+			i += 2;
+		} else if(left > 2 && byte && sequ(t[1].str, "#00") && sequ(t[2].str, "SWP")) {
+			char w[6];
+			save(scope, 2, 2); /* byte widened to a short */
+			scat(scpy("#00", w, 6), t->str + 1);
+			settoken(&s->tokens[o++], intern(w));
+			i += 3;
+		} else {
+			s->tokens[o++] = *t;
+			i++;
+			continue;
+		}
+		changes++;
+	}
+	s->len = o;
+	return changes;
+}
+
+static int
+reach(char *live, int *stack, int top, int b)
+{
+	if(!live[b])
+		live[b] = 1, stack[top++] = b;
+	return top;
+}
+
+/* Keeps the blocks reached from code under a pad, zero-page and device labels
+and the exported names, a block being what lies between two labels. */
+
+static int
+shake(Source *s, char **exports, int elen)
+{
+	static char *ends[] = {"BRK", "JMP", "JMP2", "JMPr", "JMP2r"};
+	int b, i, j, last, nb = 0, top = 0, o = 0, *first, *home, *stack;
+	char *live, **scopes, *scope = "";
+	Label *l;
+	first = alloc((s->len + 2) * sizeof(int));
+	scopes = alloc((s->len + 1) * sizeof(char *));
+	home = alloc(p.llen * sizeof(int));
+	for(i = 0; i < s->len; ++i) {
+		Token *t = &s->tokens[i];
+		if(t->rune == '@')
+			scope = t->str + 1;
+		if(!i || t->rune == '|' || t->rune == '@')
+			scopes[nb] = scope, first[nb++] = i;
+		if((l = t->rune == '@' ? findlabel(scope) : t->rune == '&' ? findlabel(sublabel('\0', scope, t->str + 1)) : NULL))
+			home[l - p.labels] = nb - 1;
+	}
+	first[nb] = s->len;
+	live = alloc(nb + 1);
+	stack = alloc((nb + 1) * sizeof(int));
+	for(b = 0; b < nb; ++b) {
+		Token *t = &s->tokens[first[b]];
+		if(t->rune != '@' || ((l = findlabel(t->str + 1)) && l->addr < TRIM))
+			top = reach(live, stack, top, b);
+	}
+	for(i = 0; i < elen; ++i) {
+		if(!(l = findlabel(exports[i])))
+			return error("Unknown export", exports[i]);
+		top = reach(live, stack, top, home[l - p.labels]);
+	}
+	while(top) {
+		b = stack[--top], last = -1;
+		for(i = first[b]; i < first[b + 1]; ++i) {
+			Token *t = &s->tokens[i];
+			if(isref(t->str) && (l = findlabel(t->str[1] == '&' ? sublabel('\0', scopes[b], t->str + 2) : t->str + 1)))
+				top = reach(live, stack, top, home[l - p.labels]);
+			if(cpos("|$@&[]", t->rune) == -1)
+				last = i;
+		}
+		for(j = 0; last != -1 && j < (int)(sizeof(ends) / sizeof(ends[0])); ++j)
+			if(sequ(s->tokens[last].str, ends[j]))
+				break;
+		if(b + 1 < nb && s->tokens[first[b + 1]].rune == '@' && (last == -1 || j == (int)(sizeof(ends) / sizeof(ends[0]))))
+			top = reach(live, stack, top, b + 1);
+	}
+	for(b = 0; b < nb; ++b)
+		for(i = first[b], l = NULL; i < first[b + 1]; ++i) {
+			Token *t = &s->tokens[i];
+			if(live[b])
+				s->tokens[o++] = *t;
+			else if(t->rune == '@' || t->rune == '&') {
+				Label *d = findlabel(t->rune == '@' ? t->str + 1 : sublabel('\0', scopes[b], t->str + 1));
+				if(d)
+					d->dropped = 1, l = l ? l : d;
+			} else if(cpos("|[]", t->rune) == -1)
+				save(l, t->rune == '$' ? shex(t->str + 1) : sihx(t->str) ? t->len / 2 : walktoken(t->str), 0);
+		}
+	s->len = o;
+	return 1;
+}
+
+/* Places the labels, or turns absolute jumps into relative ones where the
+current layout puts them in range, which only brings later labels closer. */
+
+static int
+walk(Source *s, int *segment, int relax)
+{
+	static char *jumps[][2] = {{"JMP2", "JMP"}, {"JCN2", "JCN"}, {"JSR2", "JSR"}};
+	int i, j, pads = 0, cmacr = 0, changes = 0;
+	char *scope = "";
+	Label *l, *owner = NULL;
+	Uint16 a = 0;
+	for(i = 0; i < s->len; ++i) {
+		Token *t = &s->tokens[i];
+		char *w = t->str;
+		int size;
+		if(t->rune == '|') {
+			a = shex(w + 1), pads++;
+			continue;
+		} else if(t->rune == '$') {
+			a += shex(w + 1);
+			continue;
+		} else if(t->rune == '@' || t->rune == '&') {
+			if(t->rune == '@')
+				owner = findlabel(scope = w + 1);
+			if(!relax && (l = findlabel(t->rune == '@' ? w + 1 : sublabel('\0', scope, w + 1))))
+				l->addr = a, segment[l - p.labels] = pads;
+			continue;
+		}
+		if(t->rune == '[' || t->rune == ']' || skipblock(w, &cmacr, '{', '}'))
+			continue;
+		size = sihx(w) ? t->len / 2 : walktoken(w);
+		if(relax && t->rune == ';' && i + 1 < s->len && (l = findlabel(w[1] == '&' ? sublabel('\0', scope, w + 2) : w + 1)) && segment[l - p.labels] == pads) {
+			int off = l->addr - a - 3;
+			for(j = 0; j < 3; ++j)
+				if(sequ(t[1].str, jumps[j][0]) && off >= -126 && off <= 126) {
+					char *rel = scat(scpy(",", alloc(t->len + 1), 2), w + 1);
+					settoken(t, rel);
+					settoken(t + 1, jumps[j][1]);
+					save(owner, 1, 0);
+					changes++;
+				}
+		}
+		a += size;
+	}
+	return changes;
+}
+
+static int
+optimize(Source *s, int rewrite, char **exports, int elen)
+{
+	Source flat;
+	int ok, cap = 0, *segment = alloc(p.llen * sizeof(int));
+	memset(&flat, 0, sizeof(flat));
+	flatten(&flat, &cap, s);
+	ok = !exports || shake(&flat, exports, elen);
+	while(ok && rewrite && peephole(&flat))
+		;
+	do
+		walk(&flat, segment, 0);
+	while(ok && rewrite && walk(&flat, segment, 1));
+	ok = ok && pass2(&flat);
+	free(flat.tokens);
+	return ok;
+}
+
+#pragma mark - Library
+
+int
+uxnasm(char *src, int len, unsigned char *image, int flags, Assembly *a)
+{
+	static char *none[1];
+	Source s;
+	int i, ok;
+	memset(&s, 0, sizeof(s));
+	memset(a, 0, sizeof(*a));
+	diag = a;
+	reset();
+	s.path = "";
+	s.src = memcpy(check(malloc(len + 1)), src, len), s.size = len;
+	ok = tokenize(&s) && attach(&s, 0) && (flags & (UXNASM_OPTIMIZE | UXNASM_SHAKE) ? pass1(&s) && optimize(&s, flags & UXNASM_OPTIMIZE, flags & UXNASM_SHAKE ? none : NULL, 0) : flags & UXNASM_SINGLE ? assemble(&s) : pass1(&s) && pass2(&s)) && resolved();
+	if(ok) {
+		if(p.length > TRIM)
+			memcpy(image + TRIM, p.data + TRIM, p.length - TRIM), a->length = p.length - TRIM;
+		a->labels = p.llen, a->macros = p.mlen;
+		for(i = 0; i < p.llen; ++i)
+			if(!p.labels[i].refs && !p.labels[i].dropped && !(p.labels[i].name[0] >= 'A' && p.labels[i].name[0] <= 'Z'))
+				report(1, "Unused label", p.labels[i].name);
+	}
+	unload(&s);
+	reset();
+	diag = NULL;
+	return ok;
+}
+
+#ifndef UXNASM_LIB
+
+#pragma mark - Output
+
 static void
 cleanup(char *filename)
 {
@@ -394,23 +1162,284 @@ cleanup(char *filename)
 	for(i = 0; i < p.llen; ++i)
 		if(p.labels[i].name[0] >= 'A' && p.labels[i].name[0] <= 'Z')
 			continue; /* Ignore capitalized labels(devices) */
-		else if(!p.labels[i].refs)
+		else if(!p.labels[i].refs && !p.labels[i].dropped)
 			fprintf(stderr, "--- Unused label: %s\n", p.labels[i].name);
+	for(i = 0; i < p.llen; ++i)
+		if(p.labels[i].dropped && p.labels[i].bytes)
+			fprintf(stderr, "--- Dropped %s: %d bytes\n", p.labels[i].name, p.labels[i].bytes);
+		else if(p.labels[i].bytes || p.labels[i].cycles)
+			fprintf(stderr, "--- Optimized %s: %d bytes, %d cycles\n", p.labels[i].name, p.labels[i].bytes, p.labels[i].cycles);
+	if(p.bytes || p.cycles)
+		fprintf(stderr, "Optimized %d bytes, %d cycles.\n", p.bytes, p.cycles);
 	fprintf(stderr, "Assembled %s in %.2fkb(%.2f%% used), %d labels, %d macros.\n", filename, (p.length - TRIM) / 1024.0, p.length / 652.80, p.llen, p.mlen);
 }
 
-int
-main(int argc, char *argv[])
+static FILE *
+beside(char *filename, char *ext)
 {
+	char *path = check(malloc(slen(filename) + slen(ext) + 1));
+	FILE *fp = fopen(scat(scpy(filename, path, slen(filename) + 1), ext), "wb");
+	free(path);
+	return fp;
+}
+
+static int
+writesym(char *filename)
+{
+	int i;
+	FILE *fp;
+	if(!(fp = beside(filename, ".sym")))
+		return error("Symbols failed to open", filename);
+	for(i = 0; i < p.llen; ++i) { /* address, high byte first, and name */
+		if(p.labels[i].dropped)
+			continue;
+		fputc(p.labels[i].addr >> 8, fp);
+		fputc(p.labels[i].addr & 0xff, fp);
+		fwrite(p.labels[i].name, slen(p.labels[i].name) + 1, 1, fp);
+	}
+	fclose(fp);
+	return 1;
+}
+
+/* One label per line: address, name, bytes and instructions up to the next
+label, routines counting their sublabels, and references. */
+
+static int
+writemap(char *filename)
+{
+	int i;
+	FILE *fp;
+	if(!(fp = beside(filename, ".map")))
+		return error("Map failed to open", filename);
+	for(i = 0; i < p.llen; ++i)
+		if(!p.labels[i].dropped)
+			fprintf(fp, "%04x %s %d %d %d\n", p.labels[i].addr, p.labels[i].name, p.labels[i].size, p.labels[i].ops, p.labels[i].refs);
+	fclose(fp);
+	return 1;
+}
+
+static int
+writelisting(char *filename)
+{
+	int i, j;
+	FILE *fp;
+	if(!(fp = beside(filename, ".lst")))
+		return error("Listing failed to open", filename);
+	for(i = 0; i < p.lnlen; ++i) {
+		Line *l = &lines[i];
+		int len = l->str[0] == '$' ? 0 : l->len;
+		for(j = 0; j == 0 || j < len; j += 8) {
+			int k;
+			fprintf(fp, "%04x ", (Uint16)(l->addr + j));
+			for(k = j; k < j + 8; ++k)
+				if(k < len && l->addr + k < LENGTH)
+					fprintf(fp, " %02x", p.data[l->addr + k]);
+				else
+					fputs("   ", fp);
+			fprintf(fp, j ? "\n" : "  %s\n", l->str);
+		}
+	}
+	fclose(fp);
+	return 1;
+}
+
+static int
+unit(Options *o, char *in, char *out)
+{
+	Source *s;
 	FILE *f;
-	if(argc < 3)
-		return !error("usage", "input.tal output.rom");
-	if(!(f = fopen(argv[1], "r")))
-		return !error("Load", "Failed to open source.");
-	if(!pass1(f) || !pass2(f))
-		return !error("Assembly", "Failed to assemble rom.");
-	fwrite(p.data + TRIM, p.length - TRIM, 1, fopen(argv[2], "wb"));
+	reset();
+	p.mapping = o->map, p.listing = o->listing;
+	if(!(s = source(in, 0)) || !(o->optimizing || o->shaking ? pass1(s) && optimize(s, o->optimizing, o->shaking ? o->exports : NULL, o->elen) : o->single ? assemble(s) : pass1(s) && pass2(s)) || !resolved())
+		return error("Assembly failed", in);
+	if(!(f = fopen(out, "wb")))
+		return error("Output failed to open", out);
+	fwrite(p.data + TRIM, p.length - TRIM, 1, f);
 	fclose(f);
-	cleanup(argv[2]);
-	return 0;
+	cleanup(out);
+	return writesym(out) && (!o->map || writemap(out)) && (!o->listing || writelisting(out));
 }
+
+#ifdef POSIX
+
+/* Forks workers that take the pairs in turn from a pipe, the output of each
+is held until it is done so that it is not mixed with the others. */
+
+static int
+spread(Options *o, int argc, char *argv[])
+{
+	static char buf[0x10000];
+	int i = 0, k, fds[2], workers = 0, status, ok = 1;
+	if(!pipe(fds)) {
+		for(; workers < o->jobs && workers < argc / 2; workers++) {
+			pid_t pid = fork();
+			if(pid < 0)
+				break;
+			if(!pid) {
+				close(fds[1]);
+				setvbuf(stderr, buf, _IOFBF, sizeof(buf));
+				while(read(fds[0], &k, sizeof(k)) == sizeof(k)) {
+					ok = unit(o, argv[k], argv[k + 1]) && ok;
+					fflush(stderr);
+				}
+				exit(!ok);
+			}
+		}
+		close(fds[0]);
+		for(; i < argc && workers; i += 2)
+			if(write(fds[1], &i, sizeof(i)) != sizeof(i))
+				break;
+		close(fds[1]);
+	}
+	/* the pairs no worker could take are assembled here */
+	for(; i < argc; i += 2)
+		ok = unit(o, argv[i], argv[i + 1]) && ok;
+	while(wait(&status) > 0)
+		if(!WIFEXITED(status))
+			ok = error("Assembly worker", "Stopped");
+		else if(WEXITSTATUS(status))
+			ok = 0;
+	return ok;
+}
+
+#endif
+
+static int
+build(int argc, char *argv[])
+{
+	Options o;
+	int i, ok = 1;
+	memset(&o, 0, sizeof(o));
+	for(; argc > 0; argc--, argv++)
+		if(scmp(argv[0], "-1", 3))
+			o.single = 1;
+		else if(scmp(argv[0], "-O", 3))
+			o.optimizing = 1;
+		else if(scmp(argv[0], "-x", 3))
+			o.shaking = 1;
+		else if(scmp(argv[0], "-m", 3))
+			o.map = 1;
+		else if(scmp(argv[0], "-l", 3))
+			o.listing = 1;
+		else if(scmp(argv[0], "-e", 3) && argc > 1 && o.elen < 0x40)
+			o.exports[o.elen++] = argv[1], argc--, argv++;
+		else if(scmp(argv[0], "-j", 3) && argc > 1)
+			o.jobs = atoi(argv[1]), argc--, argv++;
+		else
+			break;
+	if(argc < 2 || argc % 2)
+		return error("usage", "[-1] [-O] [-x] [-e label] [-m] [-l] [-j jobs] input.tal output.rom ...");
+#ifdef POSIX
+	if(!o.jobs)
+		o.jobs = sysconf(_SC_NPROCESSORS_ONLN);
+	if(o.jobs > 1 && argc > 2)
+		return spread(&o, argc, argv);
+#endif
+	for(i = 0; i < argc; i += 2)
+		ok = unit(&o, argv[i], argv[i + 1]) && ok;
+	return ok;
+}
+
+#ifdef POSIX
+
+/* A request is the working directory and arguments of a client, one per line,
+the reply is what the assembler printed, a null byte and the exit status. */
+
+static int
+listento(char *path, struct sockaddr_un *sa)
+{
+	if(slen(path) >= (int)sizeof(sa->sun_path))
+		return -1;
+	memset(sa, 0, sizeof(*sa));
+	sa->sun_family = AF_UNIX;
+	scpy(path, sa->sun_path, sizeof(sa->sun_path));
+	return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+static void
+respond(int conn)
+{
+	static char *buf, **args;
+	static int cap, argcap;
+	char status;
+	int n, len = 0, argc = 0, err;
+	while(buf = reserve(buf, &cap, len + 0x1000), (n = read(conn, buf + len, cap - len - 1)) > 0)
+		len += n;
+	buf[len] = '\0';
+	for(n = 0; n < len; n++) {
+		args = reserve(args, &argcap, (argc + 1) * sizeof(char *));
+		args[argc++] = buf + n;
+		while(n < len && buf[n] != '\n') n++;
+		buf[n] = '\0';
+	}
+	err = dup(2);
+	dup2(conn, 2);
+	status = argc && !chdir(cwd = args[0]) && build(argc - 1, args + 1) ? 0 : 1;
+	fflush(stderr);
+	dup2(err, 2);
+	close(err);
+	write(conn, "", 1);
+	write(conn, &status, 1);
+}
+
+static int
+serve(char *path)
+{
+	struct sockaddr_un sa;
+	int fd, conn;
+	if((fd = listento(path, &sa)) < 0)
+		return error("Server failed to open", path);
+	unlink(path);
+	if(bind(fd, (struct sockaddr *)&sa, sizeof(sa)) || listen(fd, 0x10))
+		return error("Server failed to listen", path);
+	signal(SIGPIPE, SIG_IGN);
+	fprintf(stderr, "Listening on %s\n", path);
+	while((conn = accept(fd, NULL, NULL)) >= 0) {
+		respond(conn);
+		close(conn);
+	}
+	return error("Server stopped", path);
+}
+
+static int
+request(char *path, int argc, char *argv[])
+{
+	struct sockaddr_un sa;
+	char dir[0x1000], buf[0x400];
+	int i, n, fd, status = 1, end = 0;
+	if((fd = listento(path, &sa)) < 0 || connect(fd, (struct sockaddr *)&sa, sizeof(sa)))
+		return !error("Server not found", path);
+	if(!getcwd(dir, sizeof(dir)))
+		return !error("Request", "Working directory is too long");
+	write(fd, dir, slen(dir));
+	for(i = 0; i < argc; i++)
+		write(fd, "\n", 1), write(fd, argv[i], slen(argv[i]));
+	shutdown(fd, SHUT_WR);
+	while((n = read(fd, buf, sizeof(buf))) > 0)
+		for(i = 0; i < n; i++) {
+			if(end)
+				status = buf[i];
+			else if(!buf[i])
+				end = 1;
+			else
+				fputc(buf[i], stderr);
+		}
+	close(fd);
+	return status;
+}
+
+#endif
+
+int
+main(int argc, char *argv[])
+{
+#ifdef POSIX
+	if(argc == 3 && scmp(argv[1], "-d", 3))
+		return !serve(argv[2]);
+	if(argc > 2 && scmp(argv[1], "-c", 3))
+		return request(argv[2], argc - 3, argv + 3);
+#endif
+	return !build(argc - 1, argv + 1);
+}
+
+#endif
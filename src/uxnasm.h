@@ -0,0 +1,32 @@
+/*
+Copyright (c) 2021 Devine Lu Linvega
+
+Permission to use, copy, modify, and distribute this software for any
+purpose with or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH REGARD TO THIS SOFTWARE.
+*/
+
+/* src/uxnasm.c built with -DUXNASM_LIB, without its command line */
+
+#define UXNASM_SINGLE 0x1 /* one pass, like -1 */
+#define UXNASM_OPTIMIZE 0x2 /* like -O */
+#define UXNASM_SHAKE 0x4 /* like -x */
+
+typedef struct {
+	int warning; /* 0 for errors */
+	char name[0x40], msg[0x80];
+} Diagnostic;
+
+typedef struct {
+	int length, labels, macros; /* length of the rom from 0x0100 */
+	int len; /* diagnostics, the ones past the list are dropped */
+	Diagnostic list[0x20];
+} Assembly;
+
+/* assembles len bytes of uxntal from src into image, 64kb with the program
+   at 0x0100, includes are read from the working directory. Not reentrant,
+   returns 0 when the source has errors, listed in a */
+int uxnasm(char *src, int len, unsigned char *image, int flags, Assembly *a);
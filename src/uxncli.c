@@ -1,8 +1,17 @@
+#define _FILE_OFFSET_BITS 64
 #include <stdio.h>
+#include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
 #include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "uxn.h"
+#include "uxnasm.h"
+#include "devices/file.h"
 
 /*
 Copyright (c) 2021 Devine Lu Linvega
@@ -17,7 +26,28 @@ WITH REGARD TO THIS SOFTWARE.
 
 #pragma mark - Core
 
-static Device *devsystem, *devconsole;
+/* a machine, the files its console reads from and writes to, what it
+   wrote last and has yet to reach fd, and the files it has open */
+typedef struct {
+	Uxn u;
+	int in, out, fd, len;
+	char buf[0x1000];
+	Files files;
+} Cli;
+
+typedef struct {
+	char rom[256], in[256], out[256];
+	double time;
+	int ok;
+} Job;
+
+typedef struct {
+	Job *jobs;
+	int len, next;
+	pthread_mutex_t lock;
+} Batch;
+
+static pthread_mutex_t timelock = PTHREAD_MUTEX_INITIALIZER;
 
 static int
 error(char *msg, const char *err)
@@ -44,6 +74,15 @@ inspect(Stack *s, char *name)
 
 #pragma mark - Devices
 
+static void
+flush(Cli *c)
+{
+	int i = 0, n;
+	while(i < c->len && (n = write(c->fd, c->buf + i, c->len - i)) > 0)
+		i += n;
+	c->len = 0;
+}
+
 static int
 system_talk(Device *d, Uint8 b0, Uint8 w)
 {
@@ -57,6 +96,7 @@ system_talk(Device *d, Uint8 b0, Uint8 w)
 		case 0x2: d->u->wst.ptr = d->dat[0x2]; break;
 		case 0x3: d->u->rst.ptr = d->dat[0x3]; break;
 		case 0xe:
+			flush((Cli *)d->u);
 			inspect(&d->u->wst, "Working-stack");
 			inspect(&d->u->rst, "Return-stack");
 			break;
@@ -66,31 +106,29 @@ system_talk(Device *d, Uint8 b0, Uint8 w)
 	return 1;
 }
 
+/* the bytes are held until another fd is written to, the buffer is full,
+   the input runs out or port 0x7 is written to */
+
 static int
 console_talk(Device *d, Uint8 b0, Uint8 w)
 {
-	if(w && b0 > 0x7)
-		write(b0 - 0x7, (char *)&d->dat[b0], 1);
+	Cli *c = (Cli *)d->u;
+	if(w && b0 == 0x7)
+		flush(c);
+	else if(w && (b0 == 0x8 || b0 == 0x9)) { /* output and error, no other fd */
+		int fd = b0 == 0x8 ? c->out : 2;
+		if(fd != c->fd || c->len == sizeof(c->buf))
+			flush(c), c->fd = fd;
+		c->buf[c->len++] = d->dat[b0];
+	}
 	return 1;
 }
 
 static int
 file_talk(Device *d, Uint8 b0, Uint8 w)
 {
-	Uint8 read = b0 == 0xd;
-	if(w && (read || b0 == 0xf)) {
-		char *name = (char *)&d->mem[peek16(d->dat, 0x8)];
-		Uint16 result = 0, length = peek16(d->dat, 0xa);
-		long offset = (peek16(d->dat, 0x4) << 16) + peek16(d->dat, 0x6);
-		Uint16 addr = peek16(d->dat, b0 - 1);
-		FILE *f = fopen(name, read ? "rb" : (offset ? "ab" : "wb"));
-		if(f) {
-			if(fseek(f, offset, SEEK_SET) != -1)
-				result = read ? fread(&d->mem[addr], 1, length, f) : fwrite(&d->mem[addr], 1, length, f);
-			fclose(f);
-		}
-		poke16(d->dat, 0x2, result);
-	}
+	if(w)
+		file_access(&((Cli *)d->u)->files, d, b0);
 	return 1;
 }
 
@@ -98,7 +136,9 @@ static int
 datetime_talk(Device *d, Uint8 b0, Uint8 w)
 {
 	time_t seconds = time(NULL);
-	struct tm *t = localtime(&seconds);
+	struct tm *t;
+	pthread_mutex_lock(&timelock);
+	t = localtime(&seconds);
 	t->tm_year += 1900;
 	poke16(d->dat, 0x0, t->tm_year);
 	d->dat[0x2] = t->tm_mon;
@@ -109,6 +149,7 @@ datetime_talk(Device *d, Uint8 b0, Uint8 w)
 	d->dat[0x7] = t->tm_wday;
 	poke16(d->dat, 0x08, t->tm_yday);
 	d->dat[0xa] = t->tm_isdst;
+	pthread_mutex_unlock(&timelock);
 	(void)b0;
 	(void)w;
 	return 1;
@@ -130,63 +171,467 @@ static const char *errors[] = {"underflow", "overflow", "division by zero"};
 int
 uxn_halt(Uxn *u, Uint8 error, char *name, int id)
 {
+	flush((Cli *)u);
 	fprintf(stderr, "Halted: %s %s#%04x, at 0x%04x\n", name, errors[error - 1], id, u->ram.ptr);
 	return 0;
 }
 
 static void
-run(Uxn *u)
+dispatch(Cli *c, Uint8 *in, size_t len)
 {
-	Uint16 vec = PAGE_PROGRAM;
-	uxn_eval(u, vec);
-	while((!u->dev[0].dat[0xf]) && (read(0, &devconsole->dat[0x2], 1) > 0)) {
+	Uxn *u = &c->u;
+	Device *devconsole = &u->dev[0x1];
+	Uint16 vec;
+	size_t i;
+	for(i = 0; i < len && !u->dev[0].dat[0xf]; i++) {
+		devconsole->dat[0x2] = in[i];
 		vec = peek16(devconsole->dat, 0);
 		if(!vec) vec = u->ram.ptr; /* continue after last BRK */
 		uxn_eval(u, vec);
 	}
+	flush(c);
+}
+
+/* the input is mapped when it is a file that fits in memory, or else read as
+   it comes in blocks */
+
+static void
+run(Cli *c)
+{
+	Uxn *u = &c->u;
+	Uint8 block[0x10000], *in;
+	struct stat st;
+	off_t pos;
+	long len;
+	uxn_eval(u, PAGE_PROGRAM);
+	flush(c);
+	if(!fstat(c->in, &st) && S_ISREG(st.st_mode) && (off_t)(size_t)st.st_size == st.st_size && (pos = lseek(c->in, 0, SEEK_CUR)) >= 0 && st.st_size > pos && (in = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, c->in, 0)) != MAP_FAILED) {
+		dispatch(c, in + pos, st.st_size - pos);
+		munmap(in, st.st_size);
+	} else
+		while(!u->dev[0].dat[0xf] && (len = read(c->in, block, sizeof(block))) > 0) {
+			dispatch(c, block, len);
+			file_sweep(&c->files);
+		}
+	file_close(&c->files);
+}
+
+/* the assembler keeps its state in globals, the jobs take turns */
+
+static int
+assemble(Uxn *u, FILE *f)
+{
+	static pthread_mutex_t asmlock = PTHREAD_MUTEX_INITIALIZER;
+	static Assembly a;
+	char *src;
+	long len;
+	int i, ok;
+	fseek(f, 0, SEEK_END);
+	len = ftell(f);
+	rewind(f);
+	if(len < 0 || !(src = malloc(len + 1)))
+		return 0;
+	len = fread(src, 1, len, f);
+	pthread_mutex_lock(&asmlock);
+	ok = uxnasm(src, len, u->ram.dat, 0, &a);
+	for(i = 0; i < a.len; ++i)
+		if(!a.list[i].warning)
+			error(a.list[i].name, a.list[i].msg);
+	pthread_mutex_unlock(&asmlock);
+	free(src);
+	return ok;
 }
 
 static int
 load(Uxn *u, char *filepath)
 {
 	FILE *f;
+	int ok = 1, len = strlen(filepath);
 	if(!(f = fopen(filepath, "rb")))
 		return 0;
-	fread(u->ram.dat + PAGE_PROGRAM, sizeof(u->ram.dat) - PAGE_PROGRAM, 1, f);
-	fprintf(stderr, "Loaded %s\n", filepath);
+	if(len > 4 && !strcmp(filepath + len - 4, ".tal"))
+		ok = assemble(u, f);
+	else
+		fread(u->ram.dat + PAGE_PROGRAM, sizeof(u->ram.dat) - PAGE_PROGRAM, 1, f);
+	fclose(f);
+	return ok;
+}
+
+static int
+start(Cli *c, char *rom)
+{
+	Uxn *u = &c->u;
+	c->len = 0;
+	file_init(&c->files);
+	if(!uxn_boot(u))
+		return error("Boot", "Failed");
+	if(!load(u, rom))
+		return error("Load", "Failed");
+
+	/* system   */ uxn_port(u, 0x0, system_talk);
+	/* console  */ uxn_port(u, 0x1, console_talk);
+	/* empty    */ uxn_port(u, 0x2, nil_talk);
+	/* empty    */ uxn_port(u, 0x3, nil_talk);
+	/* empty    */ uxn_port(u, 0x4, nil_talk);
+	/* empty    */ uxn_port(u, 0x5, nil_talk);
+	/* empty    */ uxn_port(u, 0x6, nil_talk);
+	/* empty    */ uxn_port(u, 0x7, nil_talk);
+	/* empty    */ uxn_port(u, 0x8, nil_talk);
+	/* empty    */ uxn_port(u, 0x9, nil_talk);
+	/* file     */ uxn_port(u, 0xa, file_talk);
+	/* datetime */ uxn_port(u, 0xb, datetime_talk);
+	/* offset   */ uxn_port(u, 0xc, nil_talk);
+	/* empty    */ uxn_port(u, 0xd, nil_talk);
+	/* empty    */ uxn_port(u, 0xe, nil_talk);
+	/* empty    */ uxn_port(u, 0xf, nil_talk);
 	return 1;
 }
 
+#pragma mark - Batch
+
+static double
+now(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static int
+runjob(Cli *c, Job *j)
+{
+	int ok = 0;
+	if((c->in = open(j->in, O_RDONLY)) < 0)
+		return error("Input", j->in);
+	if((c->out = open(j->out, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+		close(c->in);
+		return error("Output", j->out);
+	}
+	if(start(c, j->rom)) {
+		run(c);
+		ok = !c->u.wst.error && !c->u.rst.error;
+	}
+	close(c->in);
+	close(c->out);
+	return ok;
+}
+
+static void *
+work(void *arg)
+{
+	Batch *b = arg;
+	Cli *c = malloc(sizeof(Cli));
+	Job *j;
+	double t;
+	if(!c) {
+		error("Worker", "Out of memory");
+		return NULL;
+	}
+	for(;;) {
+		/* idle workers take the next job, so long jobs never hold up short ones */
+		pthread_mutex_lock(&b->lock);
+		j = b->next < b->len ? &b->jobs[b->next++] : NULL;
+		pthread_mutex_unlock(&b->lock);
+		if(!j)
+			break;
+		t = now();
+		j->ok = runjob(c, j);
+		j->time = now() - t;
+		printf("%s %s %s: %s, %.3fms\n", j->rom, j->in, j->out, j->ok ? "ok" : "failed", j->time * 1e3);
+	}
+#ifdef UXN_JIT
+	uxn_jit_free(&c->u);
+#endif
+	free(c);
+	return NULL;
+}
+
+static int
+batch(char *manifest, int workers)
+{
+	Batch b;
+	pthread_t *threads;
+	FILE *f;
+	char line[1024];
+	int i, cap = 0, failed = 0;
+	double t, busy = 0;
+	if(!(f = fopen(manifest, "r")))
+		return error("Manifest", "Missing");
+	b.jobs = NULL;
+	b.len = b.next = 0;
+	while(fgets(line, sizeof(line), f)) {
+		if(b.len == cap) {
+			Job *jobs = realloc(b.jobs, (cap = cap ? cap * 2 : 64) * sizeof(Job));
+			if(!jobs) {
+				free(b.jobs);
+				fclose(f);
+				return error("Manifest", "Out of memory");
+			}
+			b.jobs = jobs;
+		}
+		switch(sscanf(line, "%255s %255s %255s", b.jobs[b.len].rom, b.jobs[b.len].in, b.jobs[b.len].out)) {
+		case EOF: break; /* blank line */
+		case 3: b.jobs[b.len++].ok = 0; break;
+		default:
+			free(b.jobs);
+			fclose(f);
+			return error("Manifest", "Expected rom, input and output");
+		}
+	}
+	fclose(f);
+	if(workers > b.len)
+		workers = b.len;
+	if(workers < 1)
+		workers = 1;
+	if(!(threads = malloc(workers * sizeof(pthread_t)))) {
+		free(b.jobs);
+		return error("Batch", "Out of memory");
+	}
+	pthread_mutex_init(&b.lock, NULL);
+	t = now();
+	for(i = 0; i < workers; i++)
+		if(pthread_create(&threads[i], NULL, work, &b))
+			break;
+	if(!i)
+		work(&b);
+	while(i--)
+		pthread_join(threads[i], NULL);
+	t = now() - t;
+	for(i = 0; i < b.len; i++) {
+		failed += !b.jobs[i].ok;
+		busy += b.jobs[i].time;
+	}
+	printf("%d jobs, %d failed, %d workers: %.3fs wall, %.3fs in jobs\n", b.len, failed, workers, t, busy);
+	pthread_mutex_destroy(&b.lock);
+	free(threads);
+	free(b.jobs);
+	return !failed;
+}
+
+#pragma mark - Stats
+
+#if defined(UXN_STATS) || defined(UXN_PROFILE)
+
+#define TOP 16
+
+static char ops[][4] = {
+	"LIT", "INC", "POP", "DUP", "NIP", "SWP", "OVR", "ROT",
+	"EQU", "NEQ", "GTH", "LTH", "JMP", "JCN", "JSR", "STH",
+	"LDZ", "STZ", "LDR", "STR", "LDA", "STA", "DEI", "DEO",
+	"ADD", "SUB", "MUL", "DIV", "AND", "ORA", "EOR", "SFT"};
+
+static void
+opname(FILE *f, Uint8 op)
+{
+	fprintf(f, " %s%s%s%s", ops[op & 0x1f], op & 0x20 ? "2" : "", op & 0x1f && op & 0x80 ? "k" : "", op & 0x40 ? "r" : "");
+}
+
+#endif
+
+#ifdef UXN_STATS
+
+static struct {
+	Uint8 ops[3];
+	unsigned long count;
+} top[2][TOP];
+
+static void
+gram(Uint8 *ops, int len, unsigned long count)
+{
+	int i = TOP - 1, j;
+	if(count <= top[len - 2][i].count)
+		return;
+	while(i > 0 && count > top[len - 2][i - 1].count) {
+		top[len - 2][i] = top[len - 2][i - 1];
+		i--;
+	}
+	for(j = 0; j < len; j++)
+		top[len - 2][i].ops[j] = ops[j];
+	top[len - 2][i].count = count;
+}
+
+static void
+stats(void)
+{
+	int i, j, k;
+	uxn_grams(gram);
+	for(k = 0; k < 2; k++) {
+		fprintf(stderr, "\n%s\n", k ? "Triples" : "Pairs");
+		for(i = 0; i < TOP && top[k][i].count; i++) {
+			fprintf(stderr, "%12lu ", top[k][i].count);
+			for(j = 0; j < k + 2; j++)
+				opname(stderr, top[k][i].ops[j]);
+			fprintf(stderr, "\n");
+		}
+	}
+}
+
+#endif
+
+#ifdef UXN_PROFILE
+
+static unsigned long opcounts[0x100], addrcounts[0x10000], inclusive[0x10000], exclusive[0x10000];
+static char *names[0x10000], *symbols;
+static FILE *folded;
+
+static void
+loadsym(char *rom)
+{
+	FILE *f;
+	char path[0x400];
+	long len, i;
+	if(strlen(rom) > sizeof(path) - 5 || !(f = fopen(strcat(strcpy(path, rom), ".sym"), "rb")))
+		return;
+	fseek(f, 0, SEEK_END);
+	len = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	/* a big-endian address, then the label and its null */
+	if((symbols = malloc(len + 1)) && fread(symbols, 1, len, f) == (size_t)len) {
+		for(symbols[len] = 0, i = 0; i + 2 < len; i += strlen(symbols + i) + 1) {
+			Uint16 addr = (Uint8)symbols[i] << 8 | (Uint8)symbols[i + 1];
+			if(!names[addr])
+				names[addr] = symbols + i + 2;
+			i += 2;
+		}
+	}
+	fclose(f);
+}
+
+/* an address as the label it is in */
+static void
+where(FILE *f, Uint16 addr)
+{
+	Uint16 a = addr;
+	while(!names[a] && a > PAGE_PROGRAM)
+		a--;
+	if(!names[a])
+		fprintf(f, "0x%04x", addr);
+	else if(a == addr)
+		fprintf(f, "%s", names[a]);
+	else
+		fprintf(f, "%s+%d", names[a], addr - a);
+}
+
+static void
+frame(Uint16 *calls, int depth, unsigned long count)
+{
+	int i, j;
+	for(i = 0; i < depth; i++) {
+		where(folded, calls[i]);
+		fputc(i < depth - 1 ? ';' : ' ', folded);
+		/* recursion counts once */
+		for(j = 0; j < i && calls[j] != calls[i]; j++)
+			;
+		if(j == i)
+			inclusive[calls[i]] += count;
+	}
+	fprintf(folded, "%lu\n", count);
+	exclusive[calls[depth - 1]] += count;
+}
+
+static void
+rank(unsigned long *counts, long len, long *top)
+{
+	long i, j, k;
+	for(j = 0; j < TOP; j++)
+		top[j] = -1;
+	for(i = 0; i < len; i++) {
+		if(!counts[i] || (top[TOP - 1] >= 0 && counts[i] <= counts[top[TOP - 1]]))
+			continue;
+		for(j = TOP - 1; j > 0 && (top[j - 1] < 0 || counts[i] > counts[top[j - 1]]); j--)
+			;
+		for(k = TOP - 1; k > j; k--)
+			top[k] = top[k - 1];
+		top[j] = i;
+	}
+}
+
+static int
+profile(char *path, char *rom)
+{
+	long top[TOP], i;
+	if(!(folded = fopen(path, "w")))
+		return error("Profile", path);
+	loadsym(rom);
+	uxn_profile(opcounts, addrcounts, frame);
+	fclose(folded);
+	fprintf(stderr, "\nOpcodes\n");
+	for(rank(opcounts, 0x100, top), i = 0; i < TOP && top[i] >= 0; i++) {
+		fprintf(stderr, "%12lu ", opcounts[top[i]]);
+		opname(stderr, top[i]);
+		fprintf(stderr, "\n");
+	}
+	fprintf(stderr, "\nAddresses\n");
+	for(rank(addrcounts, 0x10000, top), i = 0; i < TOP && top[i] >= 0; i++) {
+		fprintf(stderr, "%12lu  0x%04lx ", addrcounts[top[i]], top[i]);
+		where(stderr, top[i]);
+		fprintf(stderr, "\n");
+	}
+	fprintf(stderr, "\nSubroutines   inclusive   exclusive\n");
+	for(rank(inclusive, 0x10000, top), i = 0; i < TOP && top[i] >= 0; i++) {
+		fprintf(stderr, "%12lu%12lu  ", inclusive[top[i]], exclusive[top[i]]);
+		where(stderr, top[i]);
+		fprintf(stderr, "\n");
+	}
+	free(symbols);
+	return 1;
+}
+
+#endif
+
 int
 main(int argc, char **argv)
 {
-	Uxn u;
+	static Cli c;
+#ifdef UXN_STATS
+	int counting = 0;
+#endif
+#ifdef UXN_PROFILE
+	char *profiling = NULL;
+#endif
 
 	if(argc < 2)
 		return error("Input", "Missing");
-	if(!uxn_boot(&u))
-		return error("Boot", "Failed");
-	if(!load(&u, argv[1]))
-		return error("Load", "Failed");
+	if(!strcmp(argv[1], "-s")) {
+#ifdef UXN_STATS
+		if(argc < 3)
+			return error("Input", "Missing");
+		counting = 1;
+		argv++;
+#else
+		return error("Stats", "Build src/uxn.c with -DUXN_STATS");
+#endif
+	}
+	if(!strcmp(argv[1], "-p")) {
+#ifdef UXN_PROFILE
+		if(argc < 4)
+			return error("Input", "Missing");
+		profiling = argv[2];
+		argv += 2;
+#else
+		return error("Profile", "Build src/uxn.c with -DUXN_PROFILE");
+#endif
+	}
+	if(!strcmp(argv[1], "-b")) {
+		if(argc < 3)
+			return error("Manifest", "Missing");
+		return !batch(argv[2], argc > 3 ? atoi(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN));
+	}
+	if(!start(&c, argv[1]))
+		return 0;
+	fprintf(stderr, "Loaded %s\n", argv[1]);
+	c.in = 0;
+	c.out = 1;
 
-	/* system   */ devsystem = uxn_port(&u, 0x0, system_talk);
-	/* console  */ devconsole = uxn_port(&u, 0x1, console_talk);
-	/* empty    */ uxn_port(&u, 0x2, nil_talk);
-	/* empty    */ uxn_port(&u, 0x3, nil_talk);
-	/* empty    */ uxn_port(&u, 0x4, nil_talk);
-	/* empty    */ uxn_port(&u, 0x5, nil_talk);
-	/* empty    */ uxn_port(&u, 0x6, nil_talk);
-	/* empty    */ uxn_port(&u, 0x7, nil_talk);
-	/* empty    */ uxn_port(&u, 0x8, nil_talk);
-	/* empty    */ uxn_port(&u, 0x9, nil_talk);
-	/* file     */ uxn_port(&u, 0xa, file_talk);
-	/* datetime */ uxn_port(&u, 0xb, datetime_talk);
-	/* empty    */ uxn_port(&u, 0xc, nil_talk);
-	/* empty    */ uxn_port(&u, 0xd, nil_talk);
-	/* empty    */ uxn_port(&u, 0xe, nil_talk);
-	/* empty    */ uxn_port(&u, 0xf, nil_talk);
-
-	run(&u);
+	run(&c);
+#ifdef UXN_STATS
+	if(counting)
+		stats();
+#endif
+#ifdef UXN_PROFILE
+	if(profiling)
+		profile(profiling, argv[1]);
+#endif
 
 	return 0;
 }
@@ -1,8 +1,12 @@
+#define _FILE_OFFSET_BITS 64 /* for src/devices/file.h */
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
 #include <string.h>
 #include "uxn.h"
+#include "uxnasm.h"
+#include "devices/file.h"
 #include "libretro.h"
 
 #pragma GCC diagnostic push
@@ -35,12 +39,14 @@ static retro_audio_sample_batch_t audio_cb;
 #define PAD 0
 #define FIXED_SIZE 0
 #define POLYPHONY 4
+#define FRAME_STEPS 0x40000
 
 /* devices */
 static Ppu ppu;
 static Apu apu[POLYPHONY];
 static Device *devsystem, *devscreen, *devmouse, *devctrl, *devaudio0, *devconsole;
 static Uint32 *ppu_screen, stdin_event, audio0_event, palette[16];
+static Device *suspended; /* whose vector ran past its budget */
 
 static Uint8 font[][8] = {
 	{0x00, 0x7c, 0x82, 0x82, 0x82, 0x82, 0x82, 0x7c},
@@ -291,14 +297,34 @@ system_talk(Device *d, Uint8 b0, Uint8 w)
 	return 1;
 }
 
+/* console output is held until another fd is written to, the buffer is full,
+   the frame ends or port 0x7 is written to */
+
+static char conbuf[0x1000];
+static int confd, conlen;
+
+static void
+flush(void)
+{
+	int i = 0, n;
+	while(i < conlen && (n = write(confd, conbuf + i, conlen - i)) > 0)
+		i += n;
+	conlen = 0;
+}
+
 static int
 console_talk(Device *d, Uint8 b0, Uint8 w)
 {
 	if(w) {
 		if(b0 == 0x1)
 			d->vector = peek16(d->dat, 0x0);
-		if(b0 > 0x7)
-			write(b0 - 0x7, (char *)&d->dat[b0], 1);
+		if(b0 == 0x7)
+			flush();
+		if(b0 == 0x8 || b0 == 0x9) {
+			if(b0 - 0x7 != confd || conlen == sizeof(conbuf))
+				flush(), confd = b0 - 0x7;
+			conbuf[conlen++] = d->dat[b0];
+		}
 	}
 	return 1;
 }
@@ -347,23 +373,13 @@ screen_talk(Device *d, Uint8 b0, Uint8 w)
 	return 1;
 }
 
+static Files files;
+
 static int
 file_talk(Device *d, Uint8 b0, Uint8 w)
 {
-	Uint8 read = b0 == 0xd;
-	if(w && (read || b0 == 0xf)) {
-		char *name = (char *)&d->mem[peek16(d->dat, 0x8)];
-		Uint16 result = 0, length = peek16(d->dat, 0xa);
-		long offset = (peek16(d->dat, 0x4) << 16) + peek16(d->dat, 0x6);
-		Uint16 addr = peek16(d->dat, b0 - 1);
-		FILE *f = fopen(name, read ? "rb" : (offset ? "ab" : "wb"));
-		if(f) {
-			if(fseek(f, offset, SEEK_SET) != -1)
-				result = read ? fread(&d->mem[addr], 1, length, f) : fwrite(&d->mem[addr], 1, length, f);
-			fclose(f);
-		}
-		poke16(d->dat, 0x2, result);
-	}
+	if(w)
+		file_access(&files, d, b0);
 	return 1;
 }
 
@@ -427,18 +443,44 @@ static const char *errors[] = {"underflow", "overflow", "division by zero"};
 int
 uxn_halt(Uxn *u, Uint8 error, char *name, int id)
 {
+	flush();
 	fprintf(stderr, "Halted: %s %s#%04x, at 0x%04x\n", name, errors[error - 1], id, u->ram.ptr);
 	return 0;
 }
 
+static int
+assemble(Uxn *u, FILE *f)
+{
+	static Assembly a;
+	char *src;
+	long len;
+	int i, ok;
+	fseek(f, 0, SEEK_END);
+	len = ftell(f);
+	rewind(f);
+	if(len < 0 || !(src = malloc(len + 1))) return 0;
+	len = fread(src, 1, len, f);
+	ok = uxnasm(src, len, u->ram.dat, 0, &a);
+	for(i = 0; i < a.len; ++i)
+		if(!a.list[i].warning)
+			fprintf(stderr, "%s: %s\n", a.list[i].name, a.list[i].msg);
+	free(src);
+	return ok;
+}
+
 static int
 load(Uxn *u, const char *filepath)
 {
 	FILE *f;
+	int ok = 1, len = strlen(filepath);
 	if(!(f = fopen(filepath, "rb"))) return 0;
-	fread(u->ram.dat + PAGE_PROGRAM, sizeof(u->ram.dat) - PAGE_PROGRAM, 1, f);
-	fprintf(stderr, "Loaded %s\n", filepath);
-	return 1;
+	if(len > 4 && !strcmp(filepath + len - 4, ".tal"))
+		ok = assemble(u, f);
+	else
+		fread(u->ram.dat + PAGE_PROGRAM, sizeof(u->ram.dat) - PAGE_PROGRAM, 1, f);
+	fclose(f);
+	if(ok) fprintf(stderr, "Loaded %s\n", filepath);
+	return ok;
 }
 
 void
@@ -448,7 +490,7 @@ retro_get_system_info(struct retro_system_info *info)
 	info->library_name = "uxn";
 	info->library_version = "1.0";
 	info->need_fullpath = true;
-	info->valid_extensions = "rom";
+	info->valid_extensions = "rom|tal";
 }
 
 void
@@ -480,10 +522,12 @@ bool
 retro_load_game(const struct retro_game_info *game)
 {
 	enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_XRGB8888;
+	file_init(&files);
 	if (!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt))
 		return false;
 
-	load(&u, game->path);
+	if(!load(&u, game->path))
+		return false;
 
 	/* system   */ devsystem = uxn_port(&u, 0x0, system_talk);
 	/* console  */ devconsole = uxn_port(&u, 0x1, console_talk);
@@ -497,7 +541,7 @@ retro_load_game(const struct retro_game_info *game)
 	/* mouse    */ devmouse = uxn_port(&u, 0x9, nil_talk);
 	/* file     */ uxn_port(&u, 0xa, file_talk);
 	/* datetime */ uxn_port(&u, 0xb, datetime_talk);
-	/* unused   */ uxn_port(&u, 0xc, nil_talk);
+	/* offset   */ uxn_port(&u, 0xc, nil_talk);
 	/* unused   */ uxn_port(&u, 0xd, nil_talk);
 	/* unused   */ uxn_port(&u, 0xe, nil_talk);
 	/* unused   */ uxn_port(&u, 0xf, nil_talk);
@@ -505,6 +549,7 @@ retro_load_game(const struct retro_game_info *game)
 	set_size(WIDTH, HEIGHT, 0);
 
 	uxn_eval(&u, PAGE_PROGRAM);
+	flush();
 	// redraw(&u);
 
 	return true;
@@ -513,6 +558,7 @@ retro_load_game(const struct retro_game_info *game)
 void
 retro_run(void)
 {
+	Device *resumed;
 	// SDL_Event event;
 	// while(SDL_PollEvent(&event) != 0) {
 	// 	switch(event.type) {
@@ -540,10 +586,20 @@ retro_run(void)
 	// }
 
 	input_poll_cb();
-	domouse();
-	uxn_eval(&u, devmouse->vector);
-
-	uxn_eval(&u, devscreen->vector);
+	/* a vector that runs past its budget picks up again next frame, and the
+	   screen vector runs in the frame that a resumed mouse vector is done */
+	resumed = suspended;
+	if(resumed && uxn_resume(&u, FRAME_STEPS) != UXN_SUSPENDED)
+		suspended = NULL;
+	if(!resumed) {
+		domouse();
+		if(uxn_eval_steps(&u, devmouse->vector, FRAME_STEPS) == UXN_SUSPENDED)
+			suspended = devmouse;
+	}
+	if(!suspended && resumed != devscreen && uxn_eval_steps(&u, devscreen->vector, FRAME_STEPS) == UXN_SUSPENDED)
+		suspended = devscreen;
+	flush();
+	file_sweep(&files);
 	if(ppu.reqdraw || devsystem->dat[0xe])
 		redraw(&u);
 }
@@ -582,8 +638,22 @@ void retro_set_controller_port_device(unsigned port, unsigned device) {}
 size_t retro_get_memory_size(unsigned id) { return 0; }
 void * retro_get_memory_data(unsigned id) { return NULL; }
 void retro_reset(void) {}
-void retro_unload_game(void) {}
-void retro_deinit(void) {}
+
+void
+retro_unload_game(void)
+{
+	flush();
+	file_close(&files);
+}
+
+void
+retro_deinit(void)
+{
+#ifdef UXN_JIT
+	uxn_jit_free(&u);
+#endif
+}
+
 void retro_set_audio_sample(retro_audio_sample_t cb) {}
 size_t retro_serialize_size(void) { return 0; }
 bool retro_serialize(void *data, size_t size) { return false; }